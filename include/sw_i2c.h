@@ -16,6 +16,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "sw_i2c_features.h"
+
 #define I2C_ACK     0
 #define I2C_NACK    1
 
@@ -29,6 +31,11 @@ typedef struct SWI2CCONFIG {
     bool (*scl_read)(void);  ///< The Function for the Reading of the SCL GPIO, only necessary if a slave
 
     void (*delay)(const uint16_t useconds);    ///< A delay function for proper timing
+    void (*yield)(const uint16_t useconds);    ///< Optional, gives the CPU away for at least useconds, used instead of delay for long waits
+
+    void (*critical_enter)(void);   ///< Optional, masks whatever could preempt the bus timing, e.g. interrupts
+    void (*critical_exit)(void);    ///< Optional, undoes critical_enter
+
 
 } SWI2CConfig;
 
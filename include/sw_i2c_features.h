@@ -0,0 +1,120 @@
+/**
+ * \file sw_i2c_features.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Compile time switches for the optional parts of the library
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ * With ESP-IDF the switches come from Kconfig, elsewhere they can be passed as compile definitions. 
+ * Anything that isn't set keeps the full feature set: every feature on and the footprint options off.
+ * 
+ */
+
+#ifndef SW_I2C_FEATURES_H
+#define SW_I2C_FEATURES_H
+
+#ifdef ESP_PLATFORM
+
+    #include "sdkconfig.h"
+
+    #ifndef SW_I2C_ENABLE_TRACE
+        #ifdef CONFIG_SW_I2C_TRACE
+            #define SW_I2C_ENABLE_TRACE 1
+        #else
+            #define SW_I2C_ENABLE_TRACE 0
+        #endif
+    #endif
+
+    #ifndef SW_I2C_ENABLE_TIMING_CHECKER
+        #ifdef CONFIG_SW_I2C_TIMING_CHECKER
+            #define SW_I2C_ENABLE_TIMING_CHECKER 1
+        #else
+            #define SW_I2C_ENABLE_TIMING_CHECKER 0
+        #endif
+    #endif
+
+    #ifndef SW_I2C_ENABLE_SCHEDULER
+        #ifdef CONFIG_SW_I2C_SCHEDULER
+            #define SW_I2C_ENABLE_SCHEDULER 1
+        #else
+            #define SW_I2C_ENABLE_SCHEDULER 0
+        #endif
+    #endif
+
+    #ifndef SW_I2C_ENABLE_LANES
+        #ifdef CONFIG_SW_I2C_LANES
+            #define SW_I2C_ENABLE_LANES 1
+        #else
+            #define SW_I2C_ENABLE_LANES 0
+        #endif
+    #endif
+
+    #ifndef SW_I2C_ENABLE_POLLER
+        #ifdef CONFIG_SW_I2C_POLLER
+            #define SW_I2C_ENABLE_POLLER 1
+        #else
+            #define SW_I2C_ENABLE_POLLER 0
+        #endif
+    #endif
+
+    #ifndef SW_I2C_ENABLE_CRITICAL
+        #ifdef CONFIG_SW_I2C_CRITICAL
+            #define SW_I2C_ENABLE_CRITICAL 1
+        #else
+            #define SW_I2C_ENABLE_CRITICAL 0
+        #endif
+    #endif
+
+    #ifndef SW_I2C_SHARED_CONFIG
+        #ifdef CONFIG_SW_I2C_SHARED_CONFIG
+            #define SW_I2C_SHARED_CONFIG 1
+        #else
+            #define SW_I2C_SHARED_CONFIG 0
+        #endif
+    #endif
+
+    #ifndef SW_I2C_PACKED
+        #ifdef CONFIG_SW_I2C_PACKED
+            #define SW_I2C_PACKED 1
+        #else
+            #define SW_I2C_PACKED 0
+        #endif
+    #endif
+
+#endif
+
+#ifndef SW_I2C_ENABLE_TRACE
+    #define SW_I2C_ENABLE_TRACE 1    ///< Transaction tracing, sw_i2c_trace.h
+#endif
+
+#ifndef SW_I2C_ENABLE_TIMING_CHECKER
+    #define SW_I2C_ENABLE_TIMING_CHECKER 1    ///< The timing-compliance checker, sw_i2c_timing.h
+#endif
+
+#ifndef SW_I2C_ENABLE_SCHEDULER
+    #define SW_I2C_ENABLE_SCHEDULER 1    ///< The multi-bus scheduler, sw_i2c_scheduler.h
+#endif
+
+#ifndef SW_I2C_ENABLE_LANES
+    #define SW_I2C_ENABLE_LANES 1    ///< The bit-sliced lane master, sw_i2c_lanes.h
+#endif
+
+#ifndef SW_I2C_ENABLE_POLLER
+    #define SW_I2C_ENABLE_POLLER 1    ///< The register polling engine, sw_i2c_poller.h
+#endif
+
+#ifndef SW_I2C_ENABLE_CRITICAL
+    #define SW_I2C_ENABLE_CRITICAL 1    ///< Critical sections around the bus timing, sw_i2c_master.h
+#endif
+
+#ifndef SW_I2C_SHARED_CONFIG
+    #define SW_I2C_SHARED_CONFIG 0    ///< Masters point to a shared const SWI2CConfig instead of copying it
+#endif
+
+#ifndef SW_I2C_PACKED
+    #define SW_I2C_PACKED 0    ///< Masters drop the frequency and period they only need at init
+#endif
+
+#endif
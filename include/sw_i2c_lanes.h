@@ -0,0 +1,118 @@
+/**
+ * \file sw_i2c_lanes.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Bit-sliced master that runs the same transaction on parallel buses sharing one GPIO port
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef SW_I2C_LANES_H
+#define SW_I2C_LANES_H
+
+#include "sw_i2c_master.h"
+
+#define SW_I2C_LANES_MAX 16     ///< How many buses (lanes) one port can drive
+
+/// @brief Everything needed to bit-bang a whole GPIO port at once
+typedef struct SWI2CPortConfig {
+
+    void (*port_write)(const uint32_t mask, const uint32_t value);  ///< Sets the pins in mask to the levels in value, in one store
+    uint32_t (*port_read)(void);                                    ///< Reads every pin of the port in one load
+
+    void (*delay)(const uint16_t useconds);    ///< A delay function for proper timing
+
+} SWI2CPortConfig;
+
+/// @brief Parallel buses on one port, each lane has its own SDA pin and the SCL pins are shared or one per lane
+typedef struct SWI2CLanes {
+
+    SWI2CPortConfig config;                 ///< The Hardware Configuration
+    uint32_t scl_mask;                      ///< Every SCL pin of the port
+    uint32_t sda_mask;                      ///< Every SDA pin of the port
+    uint32_t sda_pins[SW_I2C_LANES_MAX];    ///< The SDA pin of each lane
+    uint8_t count;                          ///< How many lanes there are
+    SWI2CTiming timing;                     ///< The Per Phase Delays, shared by all lanes
+
+} SWI2CLanes;
+
+/**
+ * \brief Sets up a set of parallel lanes
+ *
+ * \param[out] lanes: The Lanes to Initialize
+ * \param[in] config: The Port Access Functions
+ * \param[in] scl_mask: The SCL pin(s) of the port
+ * \param[in] sda_pins: The SDA pin of each lane, exactly one bit set each
+ * \param[in] count: How many lanes there are
+ * \param[in] freq: The Clock Frequency in units of 10 Hz, see sw_i2c_period_us
+ * \return SWI2CLanes*: The Lanes or NULL if the parameters are invalid or freq is 0 or above 50000
+ */
+SWI2CLanes* sw_i2c_lanes_init(SWI2CLanes* const lanes, const SWI2CPortConfig* const config, const uint32_t scl_mask, const uint32_t* const sda_pins, const uint8_t count, const uint32_t freq);
+
+/**
+ * \brief Puts a start condition on every lane
+ *
+ * \param[in] lanes: The Lanes to Start
+ */
+void sw_i2c_lanes_start(const SWI2CLanes* const lanes);
+
+/**
+ * \brief Puts a repeated start condition on every lane
+ *
+ * \param[in] lanes: The Lanes to Restart
+ */
+void sw_i2c_lanes_restart(const SWI2CLanes* const lanes);
+
+/**
+ * \brief Puts a stop condition on every lane
+ *
+ * \param[in] lanes: The Lanes to Stop
+ */
+void sw_i2c_lanes_stop(const SWI2CLanes* const lanes);
+
+/**
+ * \brief Writes one byte per lane, with one port write per clock edge
+ *
+ * \param[in] lanes: The Lanes to Write with
+ * \param[in] data: The Byte for each lane, lanes that should stay off the bus get 0xff
+ * \return uint32_t: Bit i is set if lane i ACKed, like sw_i2c_master_write_byte
+ */
+uint32_t sw_i2c_lanes_write_byte(const SWI2CLanes* const lanes, const uint8_t* const data);
+
+/**
+ * \brief Reads one byte per lane, with one port read per bit
+ *
+ * \param[in] lanes: The Lanes to Read with
+ * \param[out] data: Where to put the byte of each lane, 0xff where the ACK slot didn't read back, like sw_i2c_master_read_byte
+ * \param[in] ack: Bit i set to ACK lane i, clear to NACK it
+ * \return uint32_t: Bit i is set if the ACK slot of lane i read back as driven
+ */
+uint32_t sw_i2c_lanes_read_byte(const SWI2CLanes* const lanes, uint8_t* const data, const uint32_t ack);
+
+/**
+ * \brief Writes to the same register of the same slave on every lane
+ *
+ * \param[in] lanes: The Lanes to Write with
+ * \param[in] s_addr: The Address of the slave on each lane
+ * \param[in] reg_addr: The Register to start at
+ * \param[in] data: size bytes for lane 0, then size bytes for lane 1 and so on
+ * \param[in] size: How many bytes to write to each lane
+ * \return uint32_t: Bit i is set if lane i ACKed every byte, a lane that NACKs is released for the rest of the frame
+ */
+uint32_t sw_i2c_lanes_write_reg(const SWI2CLanes* const lanes, const uint8_t s_addr, const uint8_t reg_addr, const void* const data, const uint16_t size);
+
+/**
+ * \brief Reads from the same register of the same slave on every lane
+ *
+ * \param[in] lanes: The Lanes to Read with
+ * \param[in] s_addr: The Address of the slave on each lane
+ * \param[in] reg_addr: The Register to start at
+ * \param[out] data: size bytes for lane 0, then size bytes for lane 1 and so on
+ * \param[in] size: How many bytes to read from each lane
+ * \return uint32_t: Bit i is set if lane i was addressed successfully and read every byte
+ */
+uint32_t sw_i2c_lanes_read_reg(const SWI2CLanes* const lanes, const uint8_t s_addr, const uint8_t reg_addr, void* const data, const uint16_t size);
+
+#endif
@@ -13,26 +13,158 @@
 #define SW_I2C_MASTER_H
 
 #include "sw_i2c.h"
+#include "sw_i2c_trace.h"
 
 /// \todo add clock stretching compatibility
 
+/// @brief How long the master waits in each phase of the bus, in microseconds
+typedef struct SWI2CTiming {
+
+    uint16_t hd_sta;        ///< Data low to clock low after a (repeated) start, tHD;STA
+    uint16_t su_sta;        ///< Clock high to data low for a repeated start, tSU;STA
+    uint16_t su_sto;        ///< Clock high to data high for a stop, tSU;STO
+    uint16_t buf;           ///< Bus free time after a stop, tBUF
+    uint16_t low;           ///< Clock low time, also covers the data setup tSU;DAT
+    uint16_t high;          ///< Clock high time, tHIGH
+
+} SWI2CTiming;
+
+/**
+ * \brief Fills in the padded delays a master starts out with
+ * 
+ * \param[out] timing: The Delays to Fill in
+ * \param[in] period_us: The Clock Period, split evenly between low and high
+ */
+void sw_i2c_timing_default(SWI2CTiming* const timing, const uint16_t period_us);
+
+/**
+ * \brief Converts a clock frequency to the period every init uses
+ * 
+ * The frequency is in units of 10 Hz, so 10000 is 100 kHz and a 10us period, the inits refuse 
+ * anything whose period comes out below SW_I2C_PERIOD_MIN_US, so above 50000
+ * 
+ * \param[in] freq: The Clock Frequency in units of 10 Hz, not 0
+ * \return uint16_t: The Clock Period in microseconds, rounded down
+ */
+uint16_t sw_i2c_period_us(const uint32_t freq);
+
+#if SW_I2C_ENABLE_CRITICAL
+
+/// @brief How much of the bus timing runs with the critical section of the config entered
+typedef enum SWI2CCriticalLevel {
+
+    SW_I2C_CRITICAL_NONE,           ///< Never enter it
+    SW_I2C_CRITICAL_BIT,            ///< Around every clock, the shortest masked intervals
+    SW_I2C_CRITICAL_BYTE,           ///< Around every byte and its ACK
+    SW_I2C_CRITICAL_TRANSACTION,    ///< From the start to the stop, no jitter at all but the longest masked intervals
+
+} SWI2CCriticalLevel;
+
+/// @brief The critical section setting of a master and what it measured
+typedef struct SWI2CCritical {
+
+    SWI2CCriticalLevel level;   ///< Which sections to mask
+    uint32_t (*micros)(void);   ///< Optional Microsecond Clock to measure the sections with
+    bool masked;                ///< If the master is inside a section right now
+    uint32_t since;             ///< When the current section was entered
+    uint32_t sections;          ///< How many sections were entered
+    uint32_t longest_us;        ///< The longest masked interval so far, needs micros
+
+} SWI2CCritical;
+
+#endif
+
 /// @brief Master Structure, represents an I2C bus master
 typedef struct SWI2CMaster {
 
+#if SW_I2C_SHARED_CONFIG
+    const SWI2CConfig* config;  ///< The Hardware Configuration, shared and usually const in flash
+#else
     SWI2CConfig config;     ///< The Hardware Configuration
-    uint32_t frequency;     ///< The Master Clock Frequency
+#endif
+#if SW_I2C_ENABLE_TRACE
+    SWI2CTrace* trace;      ///< Where to record transactions, NULL if tracing is off
+#endif
+#if SW_I2C_ENABLE_CRITICAL
+    SWI2CCritical* critical;    ///< When to enter the critical section, NULL to never
+#endif
+#if !SW_I2C_PACKED
+    uint32_t frequency;     ///< The Master Clock Frequency in units of 10 Hz
     uint16_t period_us;     ///< The Period of the Clock in Microseconds
+#endif
+    SWI2CTiming timing;     ///< The Per Phase Delays, derived from the period until set otherwise
+    uint16_t yield_threshold_us;    ///< Waits at least this long yield instead of spinning, UINT16_MAX to always spin
     bool started;           ///< If The Communication is Started
 
 } SWI2CMaster;
 
+#define SW_I2C_GENERAL_CALL 0x00  ///< The address every slave that supports the general call answers to
+#define SW_I2C_FANOUT_MAX   32    ///< How many targets one fan-out can reach, one bit each in the result
+
+#define SW_I2C_PERIOD_MIN_US 2  ///< The shortest clock period an init accepts, 1us low and 1us high
+#define SW_I2C_YIELD_FACTOR 2   ///< Calibration only yields for waits at least this many times the worst yield overshoot
+
+/**
+ * \brief The Hardware Configuration of a master, wherever it is kept
+ * 
+ * \param[in] master: The Master to get the configuration of
+ * \return const SWI2CConfig*: The Configuration
+ */
+static inline const SWI2CConfig* sw_i2c_master_config(const SWI2CMaster* const master) {
+
+#if SW_I2C_SHARED_CONFIG
+    return master->config;
+#else
+    return &master->config;
+#endif
+
+}
+
+/**
+ * \brief If the master is inside a critical section right now
+ * 
+ * \param[in] master: The Master to Check
+ * \return true: If whatever the config masks is masked
+ * \return false: If not, or critical sections are compiled out
+ */
+static inline bool sw_i2c_master_masked(const SWI2CMaster* const master) {
+
+#if SW_I2C_ENABLE_CRITICAL
+    return master->critical != NULL && master->critical->masked;
+#else
+    (void)master;
+    return false;
+#endif
+
+}
+
+/**
+ * \brief Waits for a phase of the bus, spinning for short waits and yielding for long ones
+ * 
+ * A yield may come back late, which only ever stretches a phase, so the bus stays within spec.
+ * Inside a critical section the master always spins.
+ * 
+ * \param[in] master: The Master that is waiting
+ * \param[in] useconds: How long to wait at least
+ */
+static inline void sw_i2c_master_delay(const SWI2CMaster* const master, const uint16_t useconds) {
+
+    const SWI2CConfig* const config = sw_i2c_master_config(master);
+    // UINT16_MAX is the never-yield setting, not a threshold a maximal wait reaches
+    if(master->yield_threshold_us != UINT16_MAX && useconds >= master->yield_threshold_us && config->yield != NULL && !sw_i2c_master_masked(master))
+        config->yield(useconds);
+    else
+        config->delay(useconds);
+
+}
+
 /**
  * \brief 
  * 
  * \param master
- * \param config
- * \param freq
- * \return I2CMaster* 
+ * \param config: Copied into the master, or only pointed to with SW_I2C_SHARED_CONFIG so it has to outlive the master
+ * \param freq: The Clock Frequency in units of 10 Hz, see sw_i2c_period_us
+ * \return I2CMaster*: The Master or NULL if the config is incomplete or freq is 0 or above 50000
  */
 SWI2CMaster* sw_i2c_master_init(SWI2CMaster* const master, const SWI2CConfig* const config, const uint32_t freq);
 
@@ -43,6 +175,70 @@ SWI2CMaster* sw_i2c_master_init(SWI2CMaster* const master, const SWI2CConfig* co
  */
 void sw_i2c_master_deinit(SWI2CMaster* const master);
 
+/**
+ * \brief Replaces the per phase delays of the master, e.g. with ones found by the timing checker
+ * 
+ * \param[in] master: The Master to Change
+ * \param[in] timing: The New Delays
+ */
+void sw_i2c_master_set_timing(SWI2CMaster* const master, const SWI2CTiming* const timing);
+
+/**
+ * \brief Sets from which wait on the master yields instead of spinning
+ * 
+ * \param[in] master: The Master to Change
+ * \param[in] threshold_us: The Shortest Wait to yield for, UINT16_MAX to always spin
+ */
+void sw_i2c_master_set_yield_threshold(SWI2CMaster* const master, const uint16_t threshold_us);
+
+/**
+ * \brief Measures how late the yield of the config comes back and sets the yield threshold from it
+ * 
+ * Only waits of at least SW_I2C_YIELD_FACTOR times the worst overshoot yield, so a yield at most 
+ * stretches a phase by 1 / SW_I2C_YIELD_FACTOR of its length
+ * 
+ * \param[in] master: The Master to Calibrate, its config needs a yield
+ * \param[in] micros: A Microsecond Clock, only used during the calibration
+ * \return uint16_t: The New Threshold, UINT16_MAX if there is no yield or it overshoots too much to be useful
+ */
+uint16_t sw_i2c_master_calibrate_yield(SWI2CMaster* const master, uint32_t (*micros)(void));
+
+#if SW_I2C_ENABLE_CRITICAL
+
+/**
+ * \brief Sets up a critical section setting, with nothing measured yet
+ * 
+ * \param[out] critical: The Setting to Initialize
+ * \param[in] level: Which sections to mask
+ * \param[in] micros: A Microsecond Clock to measure the longest masked interval with, can be NULL
+ * \return SWI2CCritical*: The Setting or NULL if the parameters are invalid
+ */
+SWI2CCritical* sw_i2c_critical_init(SWI2CCritical* const critical, const SWI2CCriticalLevel level, uint32_t (*micros)(void));
+
+/**
+ * \brief Makes the master enter the critical section of its config as the setting says
+ * 
+ * \param[in] master: The Master to Change, must not be in the middle of a transaction
+ * \param[in] critical: The Setting, NULL to never enter the critical section
+ * \return true: If the setting is in use
+ * \return false: If the config has no critical_enter/critical_exit
+ */
+bool sw_i2c_master_critical_attach(SWI2CMaster* const master, SWI2CCritical* const critical);
+
+#endif
+
+#if SW_I2C_ENABLE_TRACE
+
+/**
+ * \brief Records every following transaction on the master into a trace ring
+ * 
+ * \param[in] master: The Master to trace
+ * \param[in] trace: The Trace to record into, NULL to stop tracing
+ */
+void sw_i2c_master_trace_attach(SWI2CMaster* const master, SWI2CTrace* const trace);
+
+#endif
+
 /**
  * \brief 
  * 
@@ -65,12 +261,68 @@ bool sw_i2c_master_ack_check(const SWI2CMaster* const master);
 
 bool sw_i2c_master_write_byte(const SWI2CMaster* const dev, const uint8_t data);
 
+/**
+ * \brief Reads a byte and answers it
+ * 
+ * \param[in] dev: The Master to read with
+ * \param[out] data: Where the byte goes, only written if the read worked
+ * \param[in] ack: I2C_ACK to ask for another byte, I2C_NACK for the last one
+ * \return true: If the ACK slot held what the master sent
+ * \return false: If something else held SDA low, the bus is in error
+ */
+bool sw_i2c_master_try_read_byte(const SWI2CMaster* const dev, uint8_t* const data, const bool ack);
+
+/**
+ * \brief Reads a byte and answers it, see sw_i2c_master_try_read_byte to tell a failure from real data
+ * 
+ * \param[in] dev: The Master to read with
+ * \param[in] ack: I2C_ACK to ask for another byte, I2C_NACK for the last one
+ * \return uint8_t: The Byte, or 0xff if the read failed
+ */
 uint8_t sw_i2c_master_read_byte(const SWI2CMaster* const dev, const bool ack);
 
 uint16_t sw_i2c_master_write_bus(const SWI2CMaster* const dev, const void* const data, const uint16_t size);
 
+/**
+ * \brief Reads bytes, ACKing all of them but the last, and stops at the first one that fails
+ * 
+ * \param[in] dev: The Master to read with
+ * \param[out] data: Where the bytes go
+ * \param[in] size: How many bytes to read
+ * \return uint16_t: How many bytes were read
+ */
 uint16_t sw_i2c_master_read_bus(const SWI2CMaster* const dev, void* const data, const uint16_t size);
 
+/// @brief How a transaction ended
+typedef enum SWI2CStatus {
+
+    SW_I2C_OK,              ///< Everything was transferred
+    SW_I2C_NACK,            ///< The slave didn't acknowledge a byte
+    SW_I2C_BUS_ERROR,       ///< Something held SDA low while the master released it
+    SW_I2C_TIMEOUT,         ///< A wait ran out of polls before its condition was met
+    SW_I2C_INVALID,         ///< The parameters don't make a transaction, the bus wasn't touched
+
+} SWI2CStatus;
+
+/// @brief Which part of a transaction it ended in
+typedef enum SWI2CPhase {
+
+    SW_I2C_PHASE_ADDRESS,       ///< The first address byte
+    SW_I2C_PHASE_REGISTER,      ///< The register address
+    SW_I2C_PHASE_READ_ADDRESS,  ///< The address byte after the repeated start of a register read
+    SW_I2C_PHASE_DATA,          ///< The data
+
+} SWI2CPhase;
+
+/// @brief Where and why a transaction ended
+typedef struct SWI2CResult {
+
+    SWI2CStatus status;     ///< How it ended
+    SWI2CPhase phase;       ///< The phase it failed in, SW_I2C_PHASE_DATA if it worked
+    uint16_t offset;        ///< How many data bytes went through, a retry can pick up from there
+
+} SWI2CResult;
+
 /**
  * \brief Tries to Connect to a Slave with the given address
  * 
@@ -83,7 +335,57 @@ uint16_t sw_i2c_master_read_bus(const SWI2CMaster* const dev, void* const data,
 bool sw_i2c_master_connect_slave(const SWI2CMaster* const dev, const uint8_t s_addr, const bool iswriting);
 
 /**
- * \brief Writes to a slave on the sw_i2c bus with address s_addr
+ * \brief Writes to a slave, ending with a STOP at the first byte that isn't acknowledged
+ * 
+ * \param[in] dev: Software I2C Device to write with
+ * \param[in] s_addr: Slave to Write to
+ * \param[in] data: Data to write to the slave
+ * \param[in] size: How many bytes to write to the slave
+ * \param[out] result: Where and why the transaction ended, can be NULL
+ * \return SWI2CStatus: SW_I2C_OK if every byte was acknowledged
+ */
+SWI2CStatus sw_i2c_master_try_write(SWI2CMaster* const dev, const uint8_t s_addr, const void* const data, const uint16_t size, SWI2CResult* const result);
+
+/**
+ * \brief Reads from a slave, ending with a STOP at the first byte that fails
+ * 
+ * \param[in] dev: Software I2C Device to read with
+ * \param[in] s_addr: The address of the slave to read from
+ * \param[out] data: The place to put the data read
+ * \param[in] size: How many bytes to read, at least 1
+ * \param[out] result: Where and why the transaction ended, can be NULL
+ * \return SWI2CStatus: SW_I2C_OK if every byte was read
+ */
+SWI2CStatus sw_i2c_master_try_read(SWI2CMaster* const dev, const uint8_t s_addr, void* const data, const uint16_t size, SWI2CResult* const result);
+
+/**
+ * \brief Writes to registers of a slave, ending with a STOP at the first byte that isn't acknowledged
+ * 
+ * \param[in] dev: Software I2C Device to write with
+ * \param[in] s_addr: The address of the slave to write to
+ * \param[in] reg_addr: The address of the register to start at/write to
+ * \param[in] data: The data to write to the register/sequence
+ * \param[in] size: The number of bytes to write
+ * \param[out] result: Where and why the transaction ended, can be NULL
+ * \return SWI2CStatus: SW_I2C_OK if every byte was acknowledged
+ */
+SWI2CStatus sw_i2c_master_try_write_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, const void* const data, const uint16_t size, SWI2CResult* const result);
+
+/**
+ * \brief Reads registers of a slave, ending with a STOP at the first byte that fails
+ * 
+ * \param[in] dev: Software I2C Device to read with
+ * \param[in] s_addr: The slave to read from
+ * \param[in] reg_addr: The Address of the register to read/start from
+ * \param[out] data: The Place to put the data
+ * \param[in] size: How many bytes to read, at least 1
+ * \param[out] result: Where and why the transaction ended, can be NULL
+ * \return SWI2CStatus: SW_I2C_OK if every byte was read
+ */
+SWI2CStatus sw_i2c_master_try_read_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, void* const data, const uint16_t size, SWI2CResult* const result);
+
+/**
+ * \brief Writes to a slave on the sw_i2c bus with address s_addr, like sw_i2c_master_try_write
  * 
  * \param[in] dev: Software I2C Device to Write/Read from
  * \param[in] s_addr: Slave to Write to
@@ -94,7 +396,7 @@ bool sw_i2c_master_connect_slave(const SWI2CMaster* const dev, const uint8_t s_a
 uint16_t sw_i2c_master_write(SWI2CMaster* const dev, const uint8_t s_addr, const void* const data, const uint16_t size);
 
 /**
- * \brief Reads from a slave on the sw_i2c bus
+ * \brief Reads from a slave on the sw_i2c bus, like sw_i2c_master_try_read
  * 
  * \param[in] dev: Software I2C Device to Write/Read with
  * \param[in] s_addr: The address of the slave to write to
@@ -105,7 +407,7 @@ uint16_t sw_i2c_master_write(SWI2CMaster* const dev, const uint8_t s_addr, const
 uint16_t sw_i2c_master_read(SWI2CMaster* const dev, const uint8_t s_addr, void* const data, const uint16_t size);
 
 /**
- * \brief Reads the value of a register from a slave
+ * \brief Reads the value of a register from a slave, like sw_i2c_master_try_read_reg
  * 
  * \param[in] dev: Software I2C Device to write/read the data with
  * \param[in] s_addr: The slave to read from
@@ -117,7 +419,7 @@ uint16_t sw_i2c_master_read(SWI2CMaster* const dev, const uint8_t s_addr, void*
 uint16_t sw_i2c_master_read_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, void* const data, const uint16_t size);
 
 /**
- * \brief Write to a register on the sw_i2c slave 
+ * \brief Write to a register on the sw_i2c slave, like sw_i2c_master_try_write_reg
  * 
  * \param[in] dev: I2C Device Created in software to write/read from
  * \param[in] s_addr: The address of the slave to write to
@@ -128,4 +430,69 @@ uint16_t sw_i2c_master_read_reg(SWI2CMaster* const dev, const uint8_t s_addr, co
  */
 uint16_t sw_i2c_master_write_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, const void* const data, const uint16_t size);
 
-#endif
\ No newline at end of file
+/**
+ * \brief Reads a status register until (status & mask) == value, without a STOP between the polls
+ * 
+ * A continuous device sends the same register over and over within one read, so every poll is 
+ * just one more byte the master ACKs, the one that matches is NACKed and the bus stopped. For 
+ * devices that auto increment, every poll sets the register again after a repeated start instead.
+ * 
+ * \param[in] dev: Software I2C Device to poll with
+ * \param[in] s_addr: The slave to poll
+ * \param[in] reg_addr: The status register
+ * \param[in] mask: The bits of the status that matter
+ * \param[in] value: What those bits have to be
+ * \param[in] max_polls: How many times to read the status before giving up
+ * \param[in] interval_us: How long to wait between two polls, the bus stays claimed meanwhile
+ * \param[in] continuous: If the slave keeps sending the same register when read on
+ * \param[out] status: The last status read, 0 if none was, can be NULL
+ * \return SWI2CStatus: SW_I2C_OK if the condition was met, SW_I2C_TIMEOUT if the polls ran out, 
+ * SW_I2C_NACK if the slave didn't acknowledge, SW_I2C_INVALID if max_polls is 0
+ */
+SWI2CStatus sw_i2c_master_wait_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, const uint8_t mask, const uint8_t value, const uint16_t max_polls, const uint16_t interval_us, const bool continuous, uint8_t* const status);
+
+/**
+ * \brief Writes to a register of every slave that takes the general call, in one transaction
+ * 
+ * The first byte after the general call address is also a command to slaves that implement 
+ * them (0x06 resets, 0x04 latches the address), the bus reserves 0x00 and gives every odd byte 
+ * the hardware general call meaning, so all of those are refused.
+ * 
+ * \param[in] dev: Software I2C Device to write with
+ * \param[in] reg_addr: The register to start at, even and not 0x00, 0x04 or 0x06
+ * \param[in] data: The data to write to the register/sequence
+ * \param[in] size: The number of bytes to write
+ * \return uint16_t: The Number of bytes at least one slave acknowledged, 0 if nobody answered or reg_addr was refused
+ */
+uint16_t sw_i2c_master_broadcast_reg(SWI2CMaster* const dev, const uint8_t reg_addr, const void* const data, const uint16_t size);
+
+/**
+ * \brief Writes the same data to a register of several slaves, joined by repeated starts into one transaction
+ * 
+ * This takes about as long on the bus as a write_reg per slave, what it buys is that nothing 
+ * else gets onto the bus between the slaves
+ * 
+ * \param[in] dev: Software I2C Device to write with
+ * \param[in] s_addrs: The slaves to write to
+ * \param[in] count: How many slaves, at most SW_I2C_FANOUT_MAX
+ * \param[in] reg_addr: The register to start at on every slave
+ * \param[in] data: The data to write to the register/sequence
+ * \param[in] size: The number of bytes to write
+ * \return uint32_t: Bit n is set if s_addrs[n] acknowledged every byte
+ */
+uint32_t sw_i2c_master_fanout_reg(SWI2CMaster* const dev, const uint8_t* const s_addrs, const uint8_t count, const uint8_t reg_addr, const void* const data, const uint16_t size);
+
+/**
+ * \brief Reads a register range back from several slaves in one transaction and compares it as it comes in
+ * 
+ * \param[in] dev: Software I2C Device to read with
+ * \param[in] s_addrs: The slaves to check
+ * \param[in] count: How many slaves, at most SW_I2C_FANOUT_MAX
+ * \param[in] reg_addr: The register to start at on every slave
+ * \param[in] data: What the registers should hold
+ * \param[in] size: The number of bytes to compare, at least 1
+ * \return uint32_t: Bit n is set if s_addrs[n] holds exactly data
+ */
+uint32_t sw_i2c_master_fanout_verify(SWI2CMaster* const dev, const uint8_t* const s_addrs, const uint8_t count, const uint8_t reg_addr, const void* const data, const uint16_t size);
+
+#endif
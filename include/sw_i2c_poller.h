@@ -0,0 +1,102 @@
+/**
+ * \file sw_i2c_poller.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Deadline driven periodic register polling, with reads that are due together merged into bursts
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef SW_I2C_POLLER_H
+#define SW_I2C_POLLER_H
+
+#include "sw_i2c_master.h"
+
+#define SW_I2C_POLLER_BURST_MAX 32  ///< The longest read a burst can be merged into
+#define SW_I2C_POLLER_MAX_JOBS  32  ///< How many jobs one poller can hold
+
+/// @brief A register range that has to be read every period, within deadline of being released
+typedef struct SWI2CPollJob {
+
+    uint8_t address;        ///< The Slave to read from
+    uint8_t reg;            ///< The first register of the range
+    uint8_t size;           ///< How many registers are in the range, at most SW_I2C_POLLER_BURST_MAX
+    uint8_t* data;          ///< Where the registers go
+    uint32_t period;        ///< Time between releases, in units of the poller clock
+    uint32_t deadline;      ///< How long after the release the read has to be done by
+    void (*done)(struct SWI2CPollJob* const job, const bool ok);   ///< Called after every read, can be NULL
+
+    uint32_t release;       ///< When the job is due next, managed by the poller
+    uint32_t runs;          ///< How many times the job was read
+    uint32_t misses;        ///< How many of those finished after the deadline
+
+} SWI2CPollJob;
+
+/// @brief What the poller has done so far
+typedef struct SWI2CPollerStats {
+
+    uint32_t dispatches;    ///< Jobs that were read
+    uint32_t bursts;        ///< Bus transactions that were made for them
+    uint32_t coalesced;     ///< Jobs that were read as part of another job's burst
+    uint32_t misses;        ///< Jobs that finished after their deadline
+    uint32_t failures;      ///< Jobs whose read was cut short
+    uint32_t worst_lateness;///< The furthest past a deadline a job finished
+
+} SWI2CPollerStats;
+
+/// @brief Polls a set of jobs on one master, earliest deadline first
+typedef struct SWI2CPoller {
+
+    SWI2CMaster* master;        ///< The Bus to poll on
+    uint32_t (*now)(void);      ///< The Clock the periods and deadlines are in
+    SWI2CPollJob** jobs;        ///< Storage for the registered jobs
+    uint8_t capacity;           ///< How many jobs fit
+    uint8_t count;              ///< How many jobs are registered
+    SWI2CPollerStats stats;     ///< What the poller has done so far
+
+} SWI2CPoller;
+
+/**
+ * \brief Sets up a poller without any jobs
+ *
+ * \param[out] poller: The Poller to Initialize
+ * \param[in] master: The Master to poll with
+ * \param[in] now: The Clock, any unit as long as the jobs use the same one, it may wrap
+ * \param[in] jobs: Storage for capacity job pointers
+ * \param[in] capacity: How many jobs can be registered, at most SW_I2C_POLLER_MAX_JOBS
+ * \return SWI2CPoller*: The Poller or NULL if the parameters are invalid
+ */
+SWI2CPoller* sw_i2c_poller_init(SWI2CPoller* const poller, SWI2CMaster* const master, uint32_t (*now)(void), SWI2CPollJob** const jobs, const uint8_t capacity);
+
+/**
+ * \brief Registers a job, it is due straight away
+ *
+ * \param[in] poller: The Poller to add to
+ * \param[in] job: The Job, address, reg, size, data, period, deadline and done have to be filled in
+ * \return true: If the job was registered
+ * \return false: If the poller is full or the job is invalid
+ */
+bool sw_i2c_poller_add(SWI2CPoller* const poller, SWI2CPollJob* const job);
+
+/**
+ * \brief Reads every job that is due, earliest deadline first, merging the ones that can share a burst
+ *
+ * Only the jobs that were due when it was called are read, each at most once, so it returns 
+ * even if the bus can't keep up. Jobs that come due meanwhile wait for the next call.
+ *
+ * \param[in] poller: The Poller to Service
+ * \return uint16_t: How many bursts were read
+ */
+uint16_t sw_i2c_poller_service(SWI2CPoller* const poller);
+
+/**
+ * \brief How long until the next job is due, so the caller knows how long it can sleep
+ *
+ * \param[in] poller: The Poller to Check
+ * \return uint32_t: Clock units until the next release, 0 if a job is due, UINT32_MAX if there are no jobs
+ */
+uint32_t sw_i2c_poller_idle_time(const SWI2CPoller* const poller);
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * \file sw_i2c_scheduler.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Cooperative scheduler that interleaves the edges of several software buses on one core
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef SW_I2C_SCHEDULER_H
+#define SW_I2C_SCHEDULER_H
+
+#include "sw_i2c_master.h"
+
+#define SW_I2C_SCHEDULER_MAX_BUSES 8    ///< How many masters one scheduler can own
+
+/// @brief The kinds of transactions the scheduler can run, the same as the blocking master calls
+typedef enum SWI2CJobKind {
+
+    SW_I2C_JOB_WRITE,       ///< Like sw_i2c_master_write
+    SW_I2C_JOB_READ,        ///< Like sw_i2c_master_read
+    SW_I2C_JOB_WRITE_REG,   ///< Like sw_i2c_master_write_reg
+    SW_I2C_JOB_READ_REG,    ///< Like sw_i2c_master_read_reg
+
+} SWI2CJobKind;
+
+/// @brief One transaction handed to the scheduler, it has to stay alive until it is no longer busy
+typedef struct SWI2CJob {
+
+    SWI2CJobKind kind;      ///< What to do
+    uint8_t address;        ///< The Slave to talk to
+    uint8_t reg;            ///< The Register to start at, for the register kinds
+    void* data;             ///< The Data to write or the place to put the data read
+    uint16_t size;          ///< How many bytes to transfer
+    uint16_t done;          ///< How many bytes were transferred, what the blocking call would have returned
+    volatile bool busy;     ///< Set while the job is queued or running
+
+} SWI2CJob;
+
+/// @brief Where a bus is within its current job
+typedef struct SWI2CSchedulerBus {
+
+    SWI2CMaster* master;    ///< The Master driving the bus
+    SWI2CJob* job;          ///< The Job being run, NULL if the bus is idle
+    uint16_t wait;          ///< Ticks left before the next edge
+    uint16_t index;         ///< Which data byte is on the wire
+    uint8_t segment;        ///< Which part of the frame is running
+    uint8_t step;           ///< Which edge within the part is next
+    uint8_t bit;            ///< Which bit of the byte is on the wire, 8 is the ACK slot
+    uint8_t byte;           ///< The Byte being shifted in or out
+    bool sample;            ///< SDA has to be sampled before the next edge
+
+} SWI2CSchedulerBus;
+
+/// @brief Owns several masters and runs their jobs in lock step
+typedef struct SWI2CScheduler {
+
+    SWI2CSchedulerBus buses[SW_I2C_SCHEDULER_MAX_BUSES];   ///< The Buses being scheduled
+    uint8_t count;                                          ///< How many buses were added
+    uint16_t tick_us;                                       ///< The common divisor of every phase delay
+    void (*delay)(const uint16_t useconds);                 ///< How to wait out a tick
+
+} SWI2CScheduler;
+
+/**
+ * \brief Sets up an empty scheduler
+ *
+ * \param[out] scheduler: The Scheduler to Initialize
+ * \param[in] delay: How to wait, the same kind of function as SWI2CConfig::delay
+ * \return SWI2CScheduler*: The Scheduler or NULL if the parameters are invalid
+ */
+SWI2CScheduler* sw_i2c_scheduler_init(SWI2CScheduler* const scheduler, void (*delay)(const uint16_t useconds));
+
+/**
+ * \brief Hands a master to the scheduler, its timing is used as is
+ *
+ * The scheduler drives the pins of its jobs itself, so only the timing and the pin functions 
+ * of the master are used. Its trace ring records nothing and its critical sections are never 
+ * entered for them. Every wait goes through the scheduler's delay, so the yield threshold is ignored.
+ *
+ * \param[in] scheduler: The Scheduler to add to
+ * \param[in] master: An Initialized Master, it must not be used directly while jobs are running on it
+ * \return int8_t: The Bus Number to submit jobs to, -1 if the scheduler is full
+ */
+int8_t sw_i2c_scheduler_add(SWI2CScheduler* const scheduler, SWI2CMaster* const master);
+
+/**
+ * \brief Queues a job on a bus
+ *
+ * \param[in] scheduler: The Scheduler that owns the bus
+ * \param[in] bus: The Bus Number from sw_i2c_scheduler_add
+ * \param[in] job: The Job to run, kind, address, reg, data and size have to be filled in
+ * \return true: If the job was accepted
+ * \return false: If the bus is still busy with another job or the job is invalid, e.g. a read of 0 bytes
+ */
+bool sw_i2c_scheduler_submit(SWI2CScheduler* const scheduler, const uint8_t bus, SWI2CJob* const job);
+
+/**
+ * \brief Drives every bus that is due and then waits until the next one is due
+ *
+ * \param[in] scheduler: The Scheduler to Run
+ * \return uint8_t: How many buses are still busy
+ */
+uint8_t sw_i2c_scheduler_poll(SWI2CScheduler* const scheduler);
+
+/**
+ * \brief Polls until every submitted job is done
+ *
+ * \param[in] scheduler: The Scheduler to Run
+ */
+void sw_i2c_scheduler_run(SWI2CScheduler* const scheduler);
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * \file sw_i2c_timing.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Checks recorded SCL/SDA edges against the I2C timing specification
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef SW_I2C_TIMING_H
+#define SW_I2C_TIMING_H
+
+#include "sw_i2c_master.h"
+
+/// @brief The bus speed modes from the I2C specification
+typedef enum SWI2CMode {
+
+    SW_I2C_MODE_STANDARD,       ///< Standard-mode, up to 100 kHz
+    SW_I2C_MODE_FAST,           ///< Fast-mode, up to 400 kHz
+    SW_I2C_MODE_FAST_PLUS,      ///< Fast-mode Plus, up to 1 MHz
+    SW_I2C_MODE_COUNT
+
+} SWI2CMode;
+
+/// @brief The timing parameters that are checked, all of them are minimums
+typedef enum SWI2CTimingParam {
+
+    SW_I2C_T_HD_STA,    ///< Hold time after a (repeated) start
+    SW_I2C_T_SU_STA,    ///< Setup time for a repeated start
+    SW_I2C_T_SU_DAT,    ///< Data setup time
+    SW_I2C_T_HD_DAT,    ///< Data hold time
+    SW_I2C_T_LOW,       ///< Clock low period
+    SW_I2C_T_HIGH,      ///< Clock high period
+    SW_I2C_T_SU_STO,    ///< Setup time for a stop
+    SW_I2C_T_BUF,       ///< Bus free time between a stop and a start
+    SW_I2C_T_COUNT
+
+} SWI2CTimingParam;
+
+/// @brief Watches the bus edge by edge and keeps the shortest time seen for every parameter
+typedef struct SWI2CTimingChecker {
+
+    uint32_t min_ns[SW_I2C_T_COUNT];    ///< Shortest observed time per parameter, UINT32_MAX if never observed
+    uint32_t samples[SW_I2C_T_COUNT];   ///< How many times each parameter was observed
+
+    uint32_t scl_rise;      ///< Time of the last SCL rising edge
+    uint32_t scl_fall;      ///< Time of the last SCL falling edge
+    uint32_t sda_change;    ///< Time of the last SDA change while SCL was low
+    uint32_t start;         ///< Time of the last (repeated) start
+    uint32_t stop;          ///< Time of the last stop
+
+    bool scl;               ///< Current SCL level
+    bool sda;               ///< Current SDA level
+    bool busy;              ///< Between a start and a stop
+    bool hold;              ///< Waiting for the first SCL fall after a start
+    bool stopped;           ///< A stop was seen, the next start measures tBUF
+    bool clocked;           ///< SCL fell since the last start, so the high time is a clock high
+    bool data;              ///< SDA changed since the last SCL fall
+
+} SWI2CTimingChecker;
+
+/**
+ * \brief The minimum a parameter is allowed to be in a mode
+ *
+ * \param[in] mode: The Bus Mode
+ * \param[in] param: The Parameter to look up
+ * \return uint32_t: The minimum time in nanoseconds
+ */
+uint32_t sw_i2c_timing_spec_ns(const SWI2CMode mode, const SWI2CTimingParam param);
+
+/**
+ * \brief Resets a checker to an idle bus with the given line levels
+ *
+ * \param[out] checker: The Checker to Reset
+ * \param[in] scl: The Current SCL Level
+ * \param[in] sda: The Current SDA Level
+ */
+void sw_i2c_timing_checker_init(SWI2CTimingChecker* const checker, const bool scl, const bool sda);
+
+/**
+ * \brief Feeds the bus state after a line changed into the checker
+ *
+ * \param[in] checker: The Checker to Update
+ * \param[in] t_ns: When the change happened, in nanoseconds
+ * \param[in] scl: The SCL Level after the change
+ * \param[in] sda: The SDA Level after the change
+ */
+void sw_i2c_timing_checker_edge(SWI2CTimingChecker* const checker, const uint32_t t_ns, const bool scl, const bool sda);
+
+/**
+ * \brief Which parameters were observed shorter than the mode allows
+ *
+ * \param[in] checker: The Checker with the Recorded Edges
+ * \param[in] mode: The Mode to check against
+ * \return uint16_t: Bit i is set if SWI2CTimingParam i was violated, 0 if compliant
+ */
+uint16_t sw_i2c_timing_checker_violations(const SWI2CTimingChecker* const checker, const SWI2CMode mode);
+
+/**
+ * \brief Works out the smallest per phase delays that keep the recorded bus compliant
+ *
+ * Every phase is shortened by the whole microseconds of slack it had, or lengthened by what it was missing.
+ * Phases that were never observed keep their current delay.
+ *
+ * \param[in] checker: The Checker with the Recorded Edges, recorded while running with current
+ * \param[in] mode: The Mode to be compliant with
+ * \param[in] current: The Delays the master was running with
+ * \param[out] timing: The Minimum Compliant Delays
+ */
+void sw_i2c_timing_checker_suggest(const SWI2CTimingChecker* const checker, const SWI2CMode mode, const SWI2CTiming* const current, SWI2CTiming* const timing);
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * \file sw_i2c_trace.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Compact binary transaction tracing for the software I2C master
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The ring is lock free for one producer (the bus) and one consumer, which may run on another core or in an ISR.
+ * The producer fills a slot and then publishes it by storing head with release semantics, the consumer loads 
+ * head with acquire semantics before it copies the slot out, so it never sees a record that is only partly written. 
+ * The other way round the consumer releases a slot by storing tail with release semantics after the copy, 
+ * and the producer loads tail with acquire semantics, so it never overwrites a record that is still being read.
+ *
+ */
+
+#ifndef SW_I2C_TRACE_H
+#define SW_I2C_TRACE_H
+
+#include <stdatomic.h>
+
+#include "sw_i2c.h"
+
+#define SW_I2C_TRACE_READ       0x01    ///< The transaction read from the slave
+#define SW_I2C_TRACE_REG        0x02    ///< The transaction addressed a register within the slave
+#define SW_I2C_TRACE_NACK       0x04    ///< The transaction ended early on a NACK
+
+#define SW_I2C_TRACE_RECORD_SIZE 16     ///< Size of an encoded record in bytes
+
+/// @brief One traced transaction, 16 bytes with no padding
+typedef struct SWI2CTraceRecord {
+
+    uint32_t timestamp;     ///< When the transaction started, in the units of the trace clock
+    uint32_t duration;      ///< How long the transaction took, in the units of the trace clock
+    uint32_t acks;          ///< Bit i is set if the i-th byte on the wire (address first) was ACKed
+    uint16_t length;        ///< How many payload bytes were transferred
+    uint8_t address;        ///< The 7 bit slave address
+    uint8_t flags;          ///< SW_I2C_TRACE_* flags
+
+} SWI2CTraceRecord;
+
+/// @brief Single producer, single consumer ring of trace records, the storage is owned by the caller
+typedef struct SWI2CTrace {
+
+    SWI2CTraceRecord* records;      ///< Preallocated record storage
+    uint32_t (*timestamp)(void);    ///< The trace clock, something cheap like a cycle or microsecond counter
+    uint16_t mask;                  ///< Capacity - 1, the capacity is a power of two
+    _Atomic uint16_t head;          ///< Next slot to write, only written by the bus
+    _Atomic uint16_t tail;          ///< Next slot to read, only written by the reader
+    _Atomic uint32_t dropped;       ///< How many records were lost because the ring was full, only written by the bus
+
+} SWI2CTrace;
+
+/**
+ * \brief Sets up a trace ring over caller provided storage
+ *
+ * \param[out] trace: The Trace to Initialize
+ * \param[in] records: Storage for the records
+ * \param[in] capacity: How many records fit in the storage, must be a power of two
+ * \param[in] timestamp: The Clock to Stamp the records with
+ * \return SWI2CTrace*: The trace or NULL if the parameters are invalid
+ */
+SWI2CTrace* sw_i2c_trace_init(SWI2CTrace* const trace, SWI2CTraceRecord* const records, const uint16_t capacity, uint32_t (*timestamp)(void));
+
+/**
+ * \brief Appends a record to the ring, drops it if the ring is full
+ *
+ * \param[in] trace: The Trace to add to
+ * \param[in] record: The Record to add
+ */
+static inline void sw_i2c_trace_push(SWI2CTrace* const trace, const SWI2CTraceRecord* const record) {
+
+    const uint16_t head = atomic_load_explicit(&trace->head, memory_order_relaxed); // only ever written here
+    const uint16_t tail = atomic_load_explicit(&trace->tail, memory_order_acquire);
+    if((uint16_t)(head - tail) > trace->mask) {
+        // a plain increment is enough with a single producer, and avoids a read-modify-write on small cores
+        const uint32_t dropped = atomic_load_explicit(&trace->dropped, memory_order_relaxed);
+        atomic_store_explicit(&trace->dropped, dropped + 1, memory_order_relaxed);
+        return;
+    }
+
+    trace->records[head & trace->mask] = *record;
+    atomic_store_explicit(&trace->head, (uint16_t)(head + 1), memory_order_release);
+
+}
+
+/**
+ * \brief Takes the oldest record out of the ring
+ *
+ * \param[in] trace: The Trace to read from
+ * \param[out] record: Where to put the record
+ * \return true: If a record was read
+ * \return false: If the ring was empty
+ */
+bool sw_i2c_trace_pop(SWI2CTrace* const trace, SWI2CTraceRecord* const record);
+
+/**
+ * \brief How many records are waiting in the ring
+ *
+ * \param[in] trace: The Trace to check
+ * \return uint16_t: The number of records in the ring
+ */
+uint16_t sw_i2c_trace_count(const SWI2CTrace* const trace);
+
+/**
+ * \brief Encodes a record as SW_I2C_TRACE_RECORD_SIZE little endian bytes, the format read by tools/sw_i2c_trace_dump
+ *
+ * \param[in] record: The Record to Encode
+ * \param[out] buffer: Where to put the encoded bytes
+ */
+void sw_i2c_trace_encode(const SWI2CTraceRecord* const record, uint8_t buffer[SW_I2C_TRACE_RECORD_SIZE]);
+
+/**
+ * \brief Decodes a record from SW_I2C_TRACE_RECORD_SIZE little endian bytes
+ *
+ * \param[out] record: Where to put the decoded record
+ * \param[in] buffer: The Encoded bytes
+ */
+void sw_i2c_trace_decode(SWI2CTraceRecord* const record, const uint8_t buffer[SW_I2C_TRACE_RECORD_SIZE]);
+
+#endif
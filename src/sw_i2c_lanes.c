@@ -0,0 +1,204 @@
+/**
+ * \file sw_i2c_lanes.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "../include/sw_i2c_lanes.h"
+
+#if SW_I2C_ENABLE_LANES
+
+SWI2CLanes* sw_i2c_lanes_init(SWI2CLanes* const lanes, const SWI2CPortConfig* const config, const uint32_t scl_mask, const uint32_t* const sda_pins, const uint8_t count, const uint32_t freq) {
+
+    if(config->port_write == NULL || config->port_read == NULL || config->delay == NULL)
+        return NULL;
+
+    if(count == 0 || count > SW_I2C_LANES_MAX || scl_mask == 0 || freq == 0 || sw_i2c_period_us(freq) < SW_I2C_PERIOD_MIN_US)
+        return NULL;
+
+    lanes->config = *config;
+    lanes->scl_mask = scl_mask;
+    lanes->sda_mask = 0;
+    lanes->count = count;
+
+    for(uint8_t i = 0; i < count; i++) {
+        const uint32_t pin = sda_pins[i];
+        if(pin == 0 || (pin & (pin - 1)) != 0 || (pin & (scl_mask | lanes->sda_mask)) != 0)
+            return NULL; // every lane needs exactly one SDA pin of its own
+
+        lanes->sda_pins[i] = pin;
+        lanes->sda_mask |= pin;
+    }
+
+    sw_i2c_timing_default(&lanes->timing, sw_i2c_period_us(freq));
+
+    return lanes;
+
+}
+
+// one clock on every lane, SCL low and every SDA in the same store
+static inline void sw_i2c_lanes_clock(const SWI2CLanes* const lanes, const uint32_t sda) {
+
+    lanes->config.port_write(lanes->scl_mask | lanes->sda_mask, sda);
+    lanes->config.delay(lanes->timing.low);
+    lanes->config.port_write(lanes->scl_mask, lanes->scl_mask);
+    lanes->config.delay(lanes->timing.high);
+
+}
+
+void sw_i2c_lanes_start(const SWI2CLanes* const lanes) {
+
+    lanes->config.port_write(lanes->sda_mask, lanes->sda_mask);
+    lanes->config.port_write(lanes->sda_mask, 0);
+    lanes->config.delay(lanes->timing.hd_sta);
+
+}
+
+void sw_i2c_lanes_restart(const SWI2CLanes* const lanes) {
+
+    lanes->config.port_write(lanes->scl_mask | lanes->sda_mask, lanes->sda_mask);
+    lanes->config.delay(lanes->timing.low);
+    lanes->config.port_write(lanes->scl_mask, lanes->scl_mask);
+    lanes->config.delay(lanes->timing.su_sta);
+    lanes->config.port_write(lanes->sda_mask, 0);
+    lanes->config.delay(lanes->timing.hd_sta);
+
+}
+
+void sw_i2c_lanes_stop(const SWI2CLanes* const lanes) {
+
+    lanes->config.port_write(lanes->scl_mask | lanes->sda_mask, 0);
+    lanes->config.delay(lanes->timing.low);
+    lanes->config.port_write(lanes->scl_mask, lanes->scl_mask);
+    lanes->config.delay(lanes->timing.su_sto);
+    lanes->config.port_write(lanes->sda_mask, lanes->sda_mask);
+    lanes->config.delay(lanes->timing.buf);
+
+}
+
+uint32_t sw_i2c_lanes_write_byte(const SWI2CLanes* const lanes, const uint8_t* const data) {
+
+    // transpose the bytes into one port word per bit before touching the bus
+    uint32_t words[8] = { 0 };
+    for(uint8_t i = 0; i < lanes->count; i++) {
+        for(uint8_t j = 0; j < 8; j++) {
+            if(data[i] & (0x80 >> j))
+                words[j] |= lanes->sda_pins[i];
+        }
+    }
+
+    for(uint8_t j = 0; j < 8; j++)
+        sw_i2c_lanes_clock(lanes, words[j]);
+
+    sw_i2c_lanes_clock(lanes, lanes->sda_mask); // let the slaves ACK
+    const uint32_t port = lanes->config.port_read();
+
+    uint32_t acked = 0;
+    for(uint8_t i = 0; i < lanes->count; i++) {
+        if((port & lanes->sda_pins[i]) == 0)
+            acked |= (uint32_t)1 << i;
+    }
+    return acked;
+
+}
+
+uint32_t sw_i2c_lanes_read_byte(const SWI2CLanes* const lanes, uint8_t* const data, const uint32_t ack) {
+
+    uint32_t words[8];
+    for(uint8_t j = 0; j < 8; j++) {
+        sw_i2c_lanes_clock(lanes, lanes->sda_mask);
+        words[j] = lanes->config.port_read();
+    }
+
+    uint32_t acks = lanes->sda_mask;
+    for(uint8_t i = 0; i < lanes->count; i++) {
+        if(ack & ((uint32_t)1 << i))
+            acks &= ~lanes->sda_pins[i];
+    }
+    sw_i2c_lanes_clock(lanes, acks);
+    const uint32_t port = lanes->config.port_read();
+
+    // and transpose the port words back into one byte per lane
+    uint32_t ok = 0;
+    for(uint8_t i = 0; i < lanes->count; i++) {
+        const uint32_t pin = lanes->sda_pins[i];
+        if((port & pin) != (acks & pin)) {
+            data[i] = 0xff;
+            continue;
+        }
+
+        uint8_t byte = 0;
+        for(uint8_t j = 0; j < 8; j++)
+            byte = (uint8_t)((byte << 1) | ((words[j] & pin) != 0));
+        data[i] = byte;
+        ok |= (uint32_t)1 << i;
+    }
+    return ok;
+
+}
+
+// puts the same byte on every active lane, the others are left released
+static uint32_t sw_i2c_lanes_write_common(const SWI2CLanes* const lanes, const uint32_t active, const uint8_t byte) {
+
+    uint8_t bytes[SW_I2C_LANES_MAX];
+    for(uint8_t i = 0; i < lanes->count; i++)
+        bytes[i] = (active & ((uint32_t)1 << i))? byte: 0xff;
+
+    return active & sw_i2c_lanes_write_byte(lanes, bytes);
+
+}
+
+uint32_t sw_i2c_lanes_write_reg(const SWI2CLanes* const lanes, const uint8_t s_addr, const uint8_t reg_addr, const void* const data, const uint16_t size) {
+
+    uint32_t active = ((uint32_t)1 << lanes->count) - 1;
+
+    sw_i2c_lanes_start(lanes);
+    active = sw_i2c_lanes_write_common(lanes, active, s_addr << 1);
+    if(active != 0)
+        active = sw_i2c_lanes_write_common(lanes, active, reg_addr);
+
+    uint8_t bytes[SW_I2C_LANES_MAX];
+    for(uint16_t j = 0; j != size && active != 0; j++) {
+        for(uint8_t i = 0; i < lanes->count; i++)
+            bytes[i] = (active & ((uint32_t)1 << i))? ((const uint8_t*)data)[i * size + j]: 0xff;
+        active &= sw_i2c_lanes_write_byte(lanes, bytes);
+    }
+
+    sw_i2c_lanes_stop(lanes);
+    return active;
+
+}
+
+uint32_t sw_i2c_lanes_read_reg(const SWI2CLanes* const lanes, const uint8_t s_addr, const uint8_t reg_addr, void* const data, const uint16_t size) {
+
+    uint32_t active = ((uint32_t)1 << lanes->count) - 1;
+
+    sw_i2c_lanes_start(lanes);
+    active = sw_i2c_lanes_write_common(lanes, active, s_addr << 1);
+    if(active != 0)
+        active = sw_i2c_lanes_write_common(lanes, active, reg_addr);
+    if(active != 0) {
+        sw_i2c_lanes_restart(lanes);
+        active = sw_i2c_lanes_write_common(lanes, active, (s_addr << 1) | 1);
+    }
+
+    uint8_t bytes[SW_I2C_LANES_MAX];
+    for(uint16_t j = 0; j != size; j++) {
+        if(active != 0)
+            active &= sw_i2c_lanes_read_byte(lanes, bytes, (j == size - 1)? 0: active);
+
+        for(uint8_t i = 0; i < lanes->count; i++)
+            ((uint8_t*)data)[i * size + j] = (active & ((uint32_t)1 << i))? bytes[i]: 0xff;
+    }
+
+    sw_i2c_lanes_stop(lanes);
+    return active;
+
+}
+
+#endif
@@ -11,60 +11,149 @@
 
 #include "../include/sw_i2c_master.h"
 
+#if SW_I2C_ENABLE_TRACE
+
+static inline uint32_t sw_i2c_trace_begin(const SWI2CMaster* const dev) {
+
+    return dev->trace? dev->trace->timestamp(): 0;
+
+}
+
+// acked is how many bytes on the wire were ACKed in a row, starting with the address
+static inline void sw_i2c_trace_end(const SWI2CMaster* const dev, const uint32_t start, const uint8_t s_addr, const uint8_t flags, const uint16_t acked, const uint16_t length) {
+
+    if(dev->trace == NULL)
+        return;
+
+    const SWI2CTraceRecord record = {
+        .timestamp = start,
+        .duration = dev->trace->timestamp() - start,
+        .acks = acked >= 32? UINT32_MAX: ((uint32_t)1 << acked) - 1,
+        .length = length,
+        .address = s_addr,
+        .flags = flags
+    };
+    sw_i2c_trace_push(dev->trace, &record);
+
+}
+
+#else
+
+// real functions rather than macros so the arguments still count as used
+static inline uint32_t sw_i2c_trace_begin(const SWI2CMaster* const dev) {
+
+    (void)dev;
+    return 0;
+
+}
+
+static inline void sw_i2c_trace_end(const SWI2CMaster* const dev, const uint32_t start, const uint8_t s_addr, const uint8_t flags, const uint16_t acked, const uint16_t length) {
+
+    (void)dev; (void)start; (void)s_addr; (void)flags; (void)acked; (void)length;
+
+}
+
+#endif
+
+#if SW_I2C_ENABLE_CRITICAL
+
+// only the level the master is set to does anything, so the sections never nest
+static inline void sw_i2c_critical_enter(const SWI2CMaster* const dev, const SWI2CCriticalLevel level) {
+
+    SWI2CCritical* const critical = dev->critical;
+    if(critical == NULL || critical->level != level || critical->masked)
+        return;
+
+    sw_i2c_master_config(dev)->critical_enter();
+    critical->masked = true;
+    critical->sections++;
+    if(critical->micros)
+        critical->since = critical->micros();
+
+}
+
+static inline void sw_i2c_critical_exit(const SWI2CMaster* const dev, const SWI2CCriticalLevel level) {
+
+    SWI2CCritical* const critical = dev->critical;
+    if(critical == NULL || critical->level != level || !critical->masked)
+        return;
+
+    if(critical->micros) {
+        const uint32_t masked = critical->micros() - critical->since;
+        if(masked > critical->longest_us)
+            critical->longest_us = masked;
+    }
+    critical->masked = false;
+    sw_i2c_master_config(dev)->critical_exit();
+
+}
+
+#else
+
+#define sw_i2c_critical_enter(dev, level) ((void)0)
+#define sw_i2c_critical_exit(dev, level) ((void)0)
+
+#endif
+
 void sw_i2c_start(SWI2CMaster* const device) {
     
+    if(!device->started)
+        sw_i2c_critical_enter(device, SW_I2C_CRITICAL_TRANSACTION);
     device->started = true;   
-    device->config.sda_write(1);
-    device->config.sda_write(0);
-    device->config.delay(5);
+    sw_i2c_master_config(device)->sda_write(1);
+    sw_i2c_master_config(device)->sda_write(0);
+    sw_i2c_master_delay(device, device->timing.hd_sta);
 
 }
 
 void sw_i2c_restart(SWI2CMaster* const device) {
     
-    device->config.delay(5);
-    device->config.scl_write(0);
-    device->config.delay(5);
-    device->config.sda_write(1);
-    device->config.delay(5);
-    device->config.scl_write(1);
-    device->config.delay(5);
-    device->config.sda_write(0);
-    device->config.delay(5);
+    sw_i2c_master_config(device)->scl_write(0);
+    sw_i2c_master_config(device)->sda_write(1);
+    sw_i2c_master_delay(device, device->timing.low);
+    sw_i2c_master_config(device)->scl_write(1);
+    sw_i2c_master_delay(device, device->timing.su_sta);
+    sw_i2c_master_config(device)->sda_write(0);
+    sw_i2c_master_delay(device, device->timing.hd_sta);
 }
 
 void sw_i2c_stop(SWI2CMaster* const device) {
 
     device->started = false;
-    device->config.delay(5);
-    device->config.scl_write(0);
-    device->config.sda_write(0);
-    device->config.delay(5);
-    device->config.scl_write(1);
-    device->config.delay(5);
-    device->config.sda_write(1);
-    device->config.delay(5);
+    sw_i2c_master_config(device)->scl_write(0);
+    sw_i2c_master_config(device)->sda_write(0);
+    sw_i2c_master_delay(device, device->timing.low);
+    sw_i2c_master_config(device)->scl_write(1);
+    sw_i2c_master_delay(device, device->timing.su_sto);
+    sw_i2c_master_config(device)->sda_write(1);
+    sw_i2c_critical_exit(device, SW_I2C_CRITICAL_TRANSACTION); // the bus is free, the rest of the wait can be preempted
+    sw_i2c_master_delay(device, device->timing.buf);
     
 }
 
 void sw_i2c_master_write_bit(const SWI2CMaster* const dev, const bool bit) {
     
-    dev->config.scl_write(0);
-    dev->config.sda_write(bit);  
-    dev->config.delay(dev->period_us / 2); 
-    dev->config.scl_write(1);    
-    dev->config.delay(dev->period_us / 2);
+    sw_i2c_critical_enter(dev, SW_I2C_CRITICAL_BIT);
+    sw_i2c_master_config(dev)->scl_write(0);
+    sw_i2c_master_config(dev)->sda_write(bit);  
+    sw_i2c_master_delay(dev, dev->timing.low); 
+    sw_i2c_master_config(dev)->scl_write(1);    
+    sw_i2c_master_delay(dev, dev->timing.high);
+    sw_i2c_critical_exit(dev, SW_I2C_CRITICAL_BIT);
 
 }
 
 bool sw_i2c_master_read_bit(const SWI2CMaster* const dev) {
 
-    dev->config.scl_write(0);
-    dev->config.sda_write(1);// let the slave drive the data 
-    dev->config.delay(dev->period_us / 2);
-    dev->config.scl_write(1);
-    dev->config.delay(dev->period_us / 2);    
-    return dev->config.sda_read();
+    sw_i2c_critical_enter(dev, SW_I2C_CRITICAL_BIT);
+    sw_i2c_master_config(dev)->scl_write(0);
+    sw_i2c_master_config(dev)->sda_write(1);// let the slave drive the data 
+    sw_i2c_master_delay(dev, dev->timing.low);
+    sw_i2c_master_config(dev)->scl_write(1);
+    sw_i2c_master_delay(dev, dev->timing.high);    
+    const bool bit = sw_i2c_master_config(dev)->sda_read();
+    sw_i2c_critical_exit(dev, SW_I2C_CRITICAL_BIT);
+    return bit;
 
 }
 
@@ -76,24 +165,46 @@ bool sw_i2c_master_ack_check(const SWI2CMaster* const master) {
 
 bool sw_i2c_master_write_byte(const SWI2CMaster* const dev, const uint8_t data) {
 
+    sw_i2c_critical_enter(dev, SW_I2C_CRITICAL_BYTE);
     for(uint8_t j = 0x80; j != 0; j >>= 1)
         sw_i2c_master_write_bit(dev, (data & j) != 0);
 
-    if(!sw_i2c_master_ack_check(dev))
-        return 0;
+    const bool acked = sw_i2c_master_ack_check(dev);
+    sw_i2c_critical_exit(dev, SW_I2C_CRITICAL_BYTE);
 
-    return 1;
+    return acked;
 
 }
 
-uint8_t sw_i2c_master_read_byte(const SWI2CMaster* const dev, const bool ack) {
+// clocks in the 8 data bits of a byte, the caller answers the ACK slot
+static uint8_t sw_i2c_master_read_bits(const SWI2CMaster* const dev) {
 
     uint8_t data = 0;
     for(uint8_t i = 7; i != UINT8_MAX; i--)
         data |= (sw_i2c_master_read_bit(dev) << i);
+    return data;
+
+}
 
+bool sw_i2c_master_try_read_byte(const SWI2CMaster* const dev, uint8_t* const data, const bool ack) {
+
+    sw_i2c_critical_enter(dev, SW_I2C_CRITICAL_BYTE);
+    const uint8_t byte = sw_i2c_master_read_bits(dev);
     sw_i2c_master_write_bit(dev, ack);
-    if(dev->config.sda_read() != ack)
+    sw_i2c_critical_exit(dev, SW_I2C_CRITICAL_BYTE);
+
+    if(sw_i2c_master_config(dev)->sda_read() != ack)
+        return false;
+
+    *data = byte;
+    return true;
+
+}
+
+uint8_t sw_i2c_master_read_byte(const SWI2CMaster* const dev, const bool ack) {
+
+    uint8_t data;
+    if(!sw_i2c_master_try_read_byte(dev, &data, ack))
         return 0xff;
 
     return data;
@@ -115,12 +226,31 @@ uint16_t sw_i2c_master_read_bus(const SWI2CMaster* const dev, void* const data,
     uint16_t i = 0;
     for(; i != size; i++) {
         bool ack = (i == size - 1)? I2C_NACK: I2C_ACK;
-        ((uint8_t*)data)[i] = sw_i2c_master_read_byte(dev, ack);
+        if(!sw_i2c_master_try_read_byte(dev, (uint8_t*)data + i, ack))
+            break;
     }
     return i;
 }
 
 
+void sw_i2c_timing_default(SWI2CTiming* const timing, const uint16_t period_us) {
+
+    // the start/stop phases keep the conservative 5us, the clock is split evenly
+    timing->hd_sta = 5;
+    timing->su_sta = 5;
+    timing->su_sto = 5;
+    timing->buf = 5;
+    timing->low = period_us / 2;
+    timing->high = period_us / 2;
+
+}
+
+uint16_t sw_i2c_period_us(const uint32_t freq) {
+
+    return (uint16_t)(100000u / freq); // the same result the float division gave, without pulling in soft-float
+
+}
+
 SWI2CMaster* sw_i2c_master_init(SWI2CMaster* const master, const SWI2CConfig* const config, const uint32_t freq) {
 
     if(config->delay == NULL)
@@ -132,12 +262,29 @@ SWI2CMaster* sw_i2c_master_init(SWI2CMaster* const master, const SWI2CConfig* co
     if(freq == 0)
         return NULL;
 
+    const uint16_t period_us = sw_i2c_period_us(freq);
+    if(period_us < SW_I2C_PERIOD_MIN_US)
+        return NULL; // the delays would round down to no clock at all
+
+#if SW_I2C_SHARED_CONFIG
+    master->config = config;
+#else
     master->config = *config;
+#endif
 
+#if !SW_I2C_PACKED
     master->frequency = freq;    
-    float period = 1.0f / (float)freq;
-    master->period_us = (uint16_t)(100000.0f * period); 
+    master->period_us = period_us;
+#endif
+    sw_i2c_timing_default(&master->timing, period_us);
+    master->yield_threshold_us = UINT16_MAX;
     master->started = false;
+#if SW_I2C_ENABLE_TRACE
+    master->trace = NULL;
+#endif
+#if SW_I2C_ENABLE_CRITICAL
+    master->critical = NULL;
+#endif
 
     return master;
 
@@ -151,14 +298,106 @@ void sw_i2c_master_deinit(SWI2CMaster* const master) {
     if(master->started)
         sw_i2c_stop(master);
     
+#if SW_I2C_SHARED_CONFIG
+    master->config = NULL;
+#else
     master->config.delay = NULL;
+    master->config.yield = NULL;
+    master->config.critical_enter = NULL;
+    master->config.critical_exit = NULL;
     master->config.scl_read = NULL;
     master->config.sda_read = NULL;
     master->config.scl_write = NULL;
     master->config.sda_write = NULL;
+#endif
+#if SW_I2C_ENABLE_TRACE
+    master->trace = NULL;
+#endif
+#if SW_I2C_ENABLE_CRITICAL
+    master->critical = NULL;
+#endif
+
+}
+
+void sw_i2c_master_set_timing(SWI2CMaster* const master, const SWI2CTiming* const timing) {
+
+    master->timing = *timing;
+
+}
+
+void sw_i2c_master_set_yield_threshold(SWI2CMaster* const master, const uint16_t threshold_us) {
+
+    master->yield_threshold_us = threshold_us;
+
+}
+
+uint16_t sw_i2c_master_calibrate_yield(SWI2CMaster* const master, uint32_t (*micros)(void)) {
+
+    const SWI2CConfig* const config = sw_i2c_master_config(master);
+    master->yield_threshold_us = UINT16_MAX;
+    if(config->yield == NULL || micros == NULL)
+        return UINT16_MAX;
+
+    // probe with the shortest and the longest phase, the overshoot of a yield is mostly a fixed cost
+    const uint16_t probes[] = { 1, master->timing.low, master->timing.high };
+    uint32_t worst = 0;
+    for(uint8_t i = 0; i < 4 * sizeof(probes) / sizeof(probes[0]); i++) {
+        const uint16_t wait = probes[i % (sizeof(probes) / sizeof(probes[0]))];
+        const uint32_t start = micros();
+        config->yield(wait);
+        const uint32_t elapsed = micros() - start;
+        if(elapsed > wait && elapsed - wait > worst)
+            worst = elapsed - wait;
+    }
+
+    const uint32_t threshold = (worst? worst: 1) * SW_I2C_YIELD_FACTOR;
+    master->yield_threshold_us = threshold < UINT16_MAX? (uint16_t)threshold: UINT16_MAX;
+
+    return master->yield_threshold_us;
+
+}
+
+#if SW_I2C_ENABLE_CRITICAL
+
+SWI2CCritical* sw_i2c_critical_init(SWI2CCritical* const critical, const SWI2CCriticalLevel level, uint32_t (*micros)(void)) {
+
+    if(critical == NULL || level > SW_I2C_CRITICAL_TRANSACTION)
+        return NULL;
+
+    critical->level = level;
+    critical->micros = micros;
+    critical->masked = false;
+    critical->since = 0;
+    critical->sections = 0;
+    critical->longest_us = 0;
+
+    return critical;
 
 }
 
+bool sw_i2c_master_critical_attach(SWI2CMaster* const master, SWI2CCritical* const critical) {
+
+    const SWI2CConfig* const config = sw_i2c_master_config(master);
+    if(critical != NULL && (config->critical_enter == NULL || config->critical_exit == NULL))
+        return false;
+
+    master->critical = critical;
+    return true;
+
+}
+
+#endif
+
+#if SW_I2C_ENABLE_TRACE
+
+void sw_i2c_master_trace_attach(SWI2CMaster* const master, SWI2CTrace* const trace) {
+
+    master->trace = trace;
+
+}
+
+#endif
+
 bool sw_i2c_master_connect_slave(const SWI2CMaster* const dev, const uint8_t s_addr, const bool iswriting) {
 
     if(dev == NULL || !dev->started)
@@ -168,72 +407,296 @@ bool sw_i2c_master_connect_slave(const SWI2CMaster* const dev, const uint8_t s_a
     
 }
 
-uint16_t sw_i2c_master_write(SWI2CMaster* const dev, const uint8_t s_addr, const void* const data, const uint16_t size) {
+// the one frame behind every transaction, reg is NULL without a register, tx is used for writes and rx for reads,
+// it ends at the first thing that goes wrong and always releases the bus
+static SWI2CStatus sw_i2c_master_transfer(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t* const reg, const bool reading, const void* const tx, void* const rx, const uint16_t size, SWI2CResult* const result) {
+
+    const uint8_t flags = (reading? SW_I2C_TRACE_READ: 0) | (reg? SW_I2C_TRACE_REG: 0);
+    SWI2CResult r = { .status = SW_I2C_OK, .phase = SW_I2C_PHASE_ADDRESS, .offset = 0 };
+    uint16_t acked = 0;
+
+    if(dev == NULL || (reading? rx == NULL || size == 0: tx == NULL && size != 0)) { // a read has to have a byte to NACK
+        r.status = SW_I2C_INVALID;
+        if(result != NULL)
+            *result = r;
+        return r.status;
+    }
 
-    //assert(dev && data && size);
+    const uint32_t t = sw_i2c_trace_begin(dev);
     sw_i2c_start(dev);
-    if(!sw_i2c_master_connect_slave(dev, s_addr, true))
-        return 0;
 
-    uint16_t val = sw_i2c_master_write_bus(dev, data, size);
-    
+    if(!sw_i2c_master_connect_slave(dev, s_addr, !reading || reg != NULL))
+        r.status = SW_I2C_NACK;
+    else
+        acked++;
+
+    if(r.status == SW_I2C_OK && reg != NULL) {
+        r.phase = SW_I2C_PHASE_REGISTER;
+        if(!sw_i2c_master_write_byte(dev, *reg))
+            r.status = SW_I2C_NACK;
+        else
+            acked++;
+    }
+
+    if(r.status == SW_I2C_OK && reg != NULL && reading) {
+        r.phase = SW_I2C_PHASE_READ_ADDRESS;
+        sw_i2c_restart(dev);
+        if(!sw_i2c_master_connect_slave(dev, s_addr, false))
+            r.status = SW_I2C_NACK;
+        else
+            acked++;
+    }
+
+    if(r.status == SW_I2C_OK) {
+        r.phase = SW_I2C_PHASE_DATA;
+        if(reading) {
+            for(; r.offset != size; r.offset++) {
+                const bool ack = (r.offset == size - 1)? I2C_NACK: I2C_ACK;
+                if(!sw_i2c_master_try_read_byte(dev, (uint8_t*)rx + r.offset, ack)) {
+                    r.status = SW_I2C_BUS_ERROR;
+                    break;
+                }
+            }
+            // the master ACKs every byte but the last, a read that failed ACKed every byte it got
+            if(r.status == SW_I2C_OK)
+                acked += r.offset - 1;
+            else
+                acked += r.offset;
+        }
+        else {
+            for(; r.offset != size; r.offset++) {
+                if(!sw_i2c_master_write_byte(dev, ((const uint8_t*)tx)[r.offset])) {
+                    r.status = SW_I2C_NACK;
+                    break;
+                }
+            }
+            acked += r.offset;
+        }
+    }
+
     sw_i2c_stop(dev);
+    sw_i2c_trace_end(dev, t, s_addr, r.status == SW_I2C_OK? flags: flags | SW_I2C_TRACE_NACK, acked, r.offset);
+
+    if(result != NULL)
+        *result = r;
+    return r.status;
+
+}
+
+SWI2CStatus sw_i2c_master_try_write(SWI2CMaster* const dev, const uint8_t s_addr, const void* const data, const uint16_t size, SWI2CResult* const result) {
+
+    return sw_i2c_master_transfer(dev, s_addr, NULL, false, data, NULL, size, result);
+
+}
+
+SWI2CStatus sw_i2c_master_try_read(SWI2CMaster* const dev, const uint8_t s_addr, void* const data, const uint16_t size, SWI2CResult* const result) {
+
+    return sw_i2c_master_transfer(dev, s_addr, NULL, true, NULL, data, size, result);
+
+}
+
+SWI2CStatus sw_i2c_master_try_write_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, const void* const data, const uint16_t size, SWI2CResult* const result) {
+
+    return sw_i2c_master_transfer(dev, s_addr, &reg_addr, false, data, NULL, size, result);
 
-    return val; // return how many bytes were sent
+}
+
+SWI2CStatus sw_i2c_master_try_read_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, void* const data, const uint16_t size, SWI2CResult* const result) {
+
+    return sw_i2c_master_transfer(dev, s_addr, &reg_addr, true, NULL, data, size, result);
+
+}
+
+uint16_t sw_i2c_master_write(SWI2CMaster* const dev, const uint8_t s_addr, const void* const data, const uint16_t size) {
+
+    SWI2CResult result;
+    sw_i2c_master_try_write(dev, s_addr, data, size, &result);
+    return result.offset; // return how many bytes were sent
 
 }
 
 uint16_t sw_i2c_master_read(SWI2CMaster* const dev, const uint8_t s_addr, void* const data, const uint16_t size) {
 
+    SWI2CResult result;
+    sw_i2c_master_try_read(dev, s_addr, data, size, &result);
+    return result.offset;
+
+}
+
+uint16_t sw_i2c_master_read_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, void* const data, const uint16_t size) {
+
+    SWI2CResult result;
+    sw_i2c_master_try_read_reg(dev, s_addr, reg_addr, data, size, &result);
+    return result.offset;
+
+}
+
+uint16_t sw_i2c_master_write_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, const void* const data, const uint16_t size) {
+
+    SWI2CResult result;
+    sw_i2c_master_try_write_reg(dev, s_addr, reg_addr, data, size, &result);
+    return result.offset;
+
+}
+
+SWI2CStatus sw_i2c_master_wait_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, const uint8_t mask, const uint8_t value, const uint16_t max_polls, const uint16_t interval_us, const bool continuous, uint8_t* const status) {
+
+    const uint8_t flags = SW_I2C_TRACE_READ | SW_I2C_TRACE_REG;
+    const uint32_t t = sw_i2c_trace_begin(dev);
+    uint16_t polls = 0, acked = 0;
+    uint8_t data = 0;
+    bool met = false;
+
+    if(status != NULL)
+        *status = 0;
+
+    if(max_polls == 0)
+        return SW_I2C_INVALID;
+
     sw_i2c_start(dev);
+    for(;;) {
 
-    if(!sw_i2c_master_connect_slave(dev, s_addr, false))
-        return 0;
+        acked = 0;
+        if(!sw_i2c_master_connect_slave(dev, s_addr, true))
+            break;
+        if(!sw_i2c_master_write_byte(dev, reg_addr)) {
+            acked = 1;
+            break;
+        }
+        sw_i2c_restart(dev);
+        if(!sw_i2c_master_connect_slave(dev, s_addr, false)) {
+            acked = 2;
+            break;
+        }
+        acked = 3;
+
+        // a device that keeps sending the same register is polled by ACKing and clocking out the next byte
+        bool last;
+        do {
+            sw_i2c_critical_enter(dev, SW_I2C_CRITICAL_BYTE);
+            data = sw_i2c_master_read_bits(dev);
+            met = (data & mask) == value;
+            polls++;
+            last = met || polls == max_polls || !continuous;
+            sw_i2c_master_write_bit(dev, last? I2C_NACK: I2C_ACK);
+            sw_i2c_critical_exit(dev, SW_I2C_CRITICAL_BYTE);
+            if(!last) {
+                acked++;
+                sw_i2c_master_delay(dev, interval_us);
+            }
+        } while(!last);
+
+        if(met || polls == max_polls)
+            break;
 
-    uint16_t i = sw_i2c_master_read_bus(dev, data, size);
+        // anything else has its pointer moved by the read, so it is set again without giving up the bus
+        sw_i2c_master_delay(dev, interval_us);
+        sw_i2c_restart(dev);
 
+    }
     sw_i2c_stop(dev);
-    
-    return i;
+
+    if(status != NULL)
+        *status = data;
+
+    sw_i2c_trace_end(dev, t, s_addr, met? flags: flags | SW_I2C_TRACE_NACK, acked, polls);
+    if(met)
+        return SW_I2C_OK;
+    return polls == max_polls? SW_I2C_TIMEOUT: SW_I2C_NACK;
 
 }
 
-uint16_t sw_i2c_master_read_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, void* const data, const uint16_t size) {
+uint16_t sw_i2c_master_broadcast_reg(SWI2CMaster* const dev, const uint8_t reg_addr, const void* const data, const uint16_t size) {
 
-    sw_i2c_start(dev);
-    if(!sw_i2c_master_connect_slave(dev, s_addr, true))
+    // 0x00 is reserved after a general call, 0x04 and 0x06 are commands and an odd byte makes it a hardware general call
+    if(reg_addr == 0x00 || reg_addr == 0x04 || reg_addr == 0x06 || (reg_addr & 1) != 0)
         return 0;
 
-    if(!sw_i2c_master_write_byte(dev, reg_addr))
-        return 0;
+    return sw_i2c_master_write_reg(dev, SW_I2C_GENERAL_CALL, reg_addr, data, size);
 
-    sw_i2c_restart(dev);
+}
+
+uint32_t sw_i2c_master_fanout_reg(SWI2CMaster* const dev, const uint8_t* const s_addrs, const uint8_t count, const uint8_t reg_addr, const void* const data, const uint16_t size) {
 
-    if(!sw_i2c_master_connect_slave(dev, s_addr, false))
+    if(count == 0 || count > SW_I2C_FANOUT_MAX)
         return 0;
 
-    uint16_t i = sw_i2c_master_read_bus(dev, data, size);
-    
+    uint32_t acked = 0;
+    sw_i2c_start(dev);
+    for(uint8_t n = 0; n < count; n++) {
+
+        if(n != 0)
+            sw_i2c_restart(dev);
+
+        const uint32_t t = sw_i2c_trace_begin(dev);
+        uint16_t acks = 0, i = 0;
+        if(sw_i2c_master_connect_slave(dev, s_addrs[n], true)) {
+            acks = 1;
+            if(sw_i2c_master_write_byte(dev, reg_addr)) {
+                i = sw_i2c_master_write_bus(dev, data, size);
+                acks = 2 + i;
+            }
+        }
+
+        // a target that NACKs is given up on, the next one still gets the whole payload
+        const bool ok = acks == 2 + size;
+        sw_i2c_trace_end(dev, t, s_addrs[n], ok? SW_I2C_TRACE_REG: SW_I2C_TRACE_REG | SW_I2C_TRACE_NACK, acks, i);
+        if(ok)
+            acked |= (uint32_t)1 << n;
+
+    }
     sw_i2c_stop(dev);
 
-    return i;
+    return acked;
 
 }
 
-uint16_t sw_i2c_master_write_reg(SWI2CMaster* const dev, const uint8_t s_addr, const uint8_t reg_addr, const void* const data, const uint16_t size) {
-
-    sw_i2c_start(dev);
+uint32_t sw_i2c_master_fanout_verify(SWI2CMaster* const dev, const uint8_t* const s_addrs, const uint8_t count, const uint8_t reg_addr, const void* const data, const uint16_t size) {
 
-    if(!sw_i2c_master_connect_slave(dev, s_addr, true))
+    if(count == 0 || count > SW_I2C_FANOUT_MAX || size == 0)
         return 0;
 
-    if(!sw_i2c_master_write_byte(dev, reg_addr))
-        return 0;
-    
-    uint16_t i = sw_i2c_master_write_bus(dev, data, size);
+    const uint8_t flags = SW_I2C_TRACE_READ | SW_I2C_TRACE_REG;
+    uint32_t matched = 0;
+    sw_i2c_start(dev);
+    for(uint8_t n = 0; n < count; n++) {
+
+        if(n != 0)
+            sw_i2c_restart(dev);
+
+        const uint32_t t = sw_i2c_trace_begin(dev);
+        uint16_t acks = 0, i = 0;
+        if(sw_i2c_master_connect_slave(dev, s_addrs[n], true)) {
+            acks = 1;
+            if(sw_i2c_master_write_byte(dev, reg_addr)) {
+                acks = 2;
+                sw_i2c_restart(dev);
+                if(sw_i2c_master_connect_slave(dev, s_addrs[n], false)) {
+                    acks = 3;
+                    // the first byte that differs is NACKed, there is no point in reading on
+                    for(; i != size; i++) {
+                        sw_i2c_critical_enter(dev, SW_I2C_CRITICAL_BYTE);
+                        const bool same = sw_i2c_master_read_bits(dev) == ((const uint8_t*)data)[i];
+                        const bool last = !same || i == size - 1;
+                        sw_i2c_master_write_bit(dev, last? I2C_NACK: I2C_ACK);
+                        sw_i2c_critical_exit(dev, SW_I2C_CRITICAL_BYTE);
+                        if(!same)
+                            break;
+                        if(!last)
+                            acks++;
+                    }
+                }
+            }
+        }
+
+        const bool ok = i == size;
+        sw_i2c_trace_end(dev, t, s_addrs[n], ok? flags: flags | SW_I2C_TRACE_NACK, acks, i);
+        if(ok)
+            matched |= (uint32_t)1 << n;
 
+    }
     sw_i2c_stop(dev);
 
-    return i;
+    return matched;
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,171 @@
+/**
+ * \file sw_i2c_poller.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include <string.h>
+
+#include "../include/sw_i2c_poller.h"
+
+#if SW_I2C_ENABLE_POLLER
+
+// the clock may wrap, so times are only ever compared through their difference
+static inline bool sw_i2c_poller_due(const SWI2CPollJob* const job, const uint32_t now) {
+
+    return (int32_t)(now - job->release) >= 0;
+
+}
+
+SWI2CPoller* sw_i2c_poller_init(SWI2CPoller* const poller, SWI2CMaster* const master, uint32_t (*now)(void), SWI2CPollJob** const jobs, const uint8_t capacity) {
+
+    if(poller == NULL || master == NULL || now == NULL || jobs == NULL || capacity == 0 || capacity > SW_I2C_POLLER_MAX_JOBS)
+        return NULL;
+
+    poller->master = master;
+    poller->now = now;
+    poller->jobs = jobs;
+    poller->capacity = capacity;
+    poller->count = 0;
+    memset(&poller->stats, 0, sizeof(poller->stats));
+
+    return poller;
+
+}
+
+bool sw_i2c_poller_add(SWI2CPoller* const poller, SWI2CPollJob* const job) {
+
+    if(poller->count == poller->capacity || job == NULL || job->data == NULL)
+        return false;
+
+    if(job->size == 0 || job->size > SW_I2C_POLLER_BURST_MAX || job->period == 0)
+        return false;
+
+    job->release = poller->now();
+    job->runs = 0;
+    job->misses = 0;
+    poller->jobs[poller->count++] = job;
+
+    return true;
+
+}
+
+uint16_t sw_i2c_poller_service(SWI2CPoller* const poller) {
+
+    uint8_t burst[SW_I2C_POLLER_BURST_MAX];
+    uint16_t bursts = 0;
+
+    // only the jobs due on entry are read, each at most once, so an overloaded bus still returns
+    const uint32_t now = poller->now();
+    uint32_t pending = 0;
+    for(uint8_t i = 0; i < poller->count; i++)
+        if(sw_i2c_poller_due(poller->jobs[i], now))
+            pending |= (uint32_t)1 << i;
+
+    while(pending) {
+
+        // the pending job with the earliest absolute deadline goes first
+        SWI2CPollJob* first = NULL;
+        for(uint8_t i = 0; i < poller->count; i++) {
+            SWI2CPollJob* const job = poller->jobs[i];
+            if(!(pending & ((uint32_t)1 << i)))
+                continue;
+            if(first == NULL || (int32_t)((job->release + job->deadline) - (first->release + first->deadline)) < 0)
+                first = job;
+        }
+
+        // grow the burst with every due job on the same slave that overlaps or touches it, until nothing else fits
+        uint16_t lo = first->reg, hi = first->reg + first->size;
+        uint32_t members = 0;
+        bool grown = true;
+        while(grown) {
+            grown = false;
+            for(uint8_t i = 0; i < poller->count; i++) {
+                const SWI2CPollJob* const job = poller->jobs[i];
+                if((members & ((uint32_t)1 << i)) || !(pending & ((uint32_t)1 << i)) || job->address != first->address)
+                    continue;
+
+                const uint16_t start = job->reg, end = job->reg + job->size;
+                if(start > hi || end < lo)
+                    continue;
+
+                const uint16_t new_lo = start < lo? start: lo, new_hi = end > hi? end: hi;
+                if(new_hi - new_lo > SW_I2C_POLLER_BURST_MAX)
+                    continue;
+
+                lo = new_lo;
+                hi = new_hi;
+                members |= (uint32_t)1 << i;
+                grown = true;
+            }
+        }
+
+        pending &= ~members;
+        const uint16_t read = sw_i2c_master_read_reg(poller->master, first->address, (uint8_t)lo, burst, hi - lo);
+        const uint32_t finished = poller->now();
+        poller->stats.bursts++;
+        bursts++;
+
+        for(uint8_t i = 0; i < poller->count; i++) {
+
+            if(!(members & ((uint32_t)1 << i)))
+                continue;
+
+            SWI2CPollJob* const job = poller->jobs[i];
+            const bool ok = read == hi - lo;
+            if(ok)
+                memcpy(job->data, burst + (job->reg - lo), job->size);
+            else
+                poller->stats.failures++;
+
+            const int32_t late = (int32_t)(finished - (job->release + job->deadline));
+            if(late > 0) {
+                job->misses++;
+                poller->stats.misses++;
+                if((uint32_t)late > poller->stats.worst_lateness)
+                    poller->stats.worst_lateness = (uint32_t)late;
+            }
+
+            job->runs++;
+            poller->stats.dispatches++;
+            if(job != first)
+                poller->stats.coalesced++;
+
+            // releases that were missed entirely are dropped instead of being made up in a burst of reads
+            job->release += job->period;
+            if(sw_i2c_poller_due(job, finished))
+                job->release = finished + job->period;
+
+            if(job->done)
+                job->done(job, ok);
+
+        }
+
+    }
+
+    return bursts;
+
+}
+
+uint32_t sw_i2c_poller_idle_time(const SWI2CPoller* const poller) {
+
+    const uint32_t now = poller->now();
+    uint32_t idle = UINT32_MAX;
+
+    for(uint8_t i = 0; i < poller->count; i++) {
+        const SWI2CPollJob* const job = poller->jobs[i];
+        if(sw_i2c_poller_due(job, now))
+            return 0;
+        if(job->release - now < idle)
+            idle = job->release - now;
+    }
+    return idle;
+
+}
+
+#endif
@@ -0,0 +1,342 @@
+/**
+ * \file sw_i2c_scheduler.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "../include/sw_i2c_scheduler.h"
+
+#if SW_I2C_ENABLE_SCHEDULER
+
+// the parts a frame is made of
+enum { SEG_START, SEG_ADDR_W, SEG_ADDR_R, SEG_REG, SEG_RESTART, SEG_TX, SEG_RX, SEG_STOP, SEG_DONE };
+
+// the frame of every job kind, the edges are the same as the blocking master calls make
+static const uint8_t frames[][8] = {
+    [SW_I2C_JOB_WRITE] =        { SEG_START, SEG_ADDR_W, SEG_TX, SEG_STOP, SEG_DONE },
+    [SW_I2C_JOB_READ] =         { SEG_START, SEG_ADDR_R, SEG_RX, SEG_STOP, SEG_DONE },
+    [SW_I2C_JOB_WRITE_REG] =    { SEG_START, SEG_ADDR_W, SEG_REG, SEG_TX, SEG_STOP, SEG_DONE },
+    [SW_I2C_JOB_READ_REG] =     { SEG_START, SEG_ADDR_W, SEG_REG, SEG_RESTART, SEG_ADDR_R, SEG_RX, SEG_STOP, SEG_DONE },
+};
+
+static uint16_t gcd(uint16_t a, uint16_t b) {
+
+    while(b != 0) {
+        const uint16_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+
+}
+
+static inline uint8_t segment(const SWI2CSchedulerBus* const bus) {
+
+    return frames[bus->job->kind][bus->segment];
+
+}
+
+static void next_segment(SWI2CSchedulerBus* const bus) {
+
+    bus->segment++;
+    bus->step = 0;
+    bus->bit = 0;
+
+}
+
+// a NACK or a failed read ends the frame early and releases the bus, like the blocking calls
+static void abort_frame(SWI2CSchedulerBus* const bus) {
+
+    while(segment(bus) != SEG_STOP)
+        bus->segment++;
+    bus->step = 0;
+
+}
+
+static inline void wait(SWI2CSchedulerBus* const bus, const uint16_t tick_us, const uint16_t useconds) {
+
+    bus->wait = (useconds + tick_us - 1) / tick_us; // rounding up can only ever lengthen a phase
+
+}
+
+// handles the SDA level sampled at the end of a clock high
+static void sampled(SWI2CSchedulerBus* const bus, const bool level) {
+
+    SWI2CJob* const job = bus->job;
+
+    if(bus->bit < 8) { // a data bit coming in
+        bus->byte = (uint8_t)((bus->byte << 1) | level);
+        bus->bit++;
+        return;
+    }
+
+    if(segment(bus) == SEG_RX) {
+        const bool ack = (bus->index == job->size - 1)? I2C_NACK: I2C_ACK;
+        if(level != ack) {
+            abort_frame(bus);
+            return;
+        }
+        ((uint8_t*)job->data)[bus->index++] = bus->byte;
+        job->done++;
+        bus->bit = 0;
+        if(bus->index == job->size)
+            next_segment(bus);
+        return;
+    }
+
+    if(level != I2C_ACK) {
+        abort_frame(bus);
+        return;
+    }
+
+    if(segment(bus) == SEG_TX) {
+        bus->index++;
+        job->done++;
+        bus->bit = 0;
+        if(bus->index == job->size)
+            next_segment(bus);
+        return;
+    }
+
+    next_segment(bus);
+
+}
+
+// one half of a clock, low with the data put on the line or high
+static void clock(SWI2CSchedulerBus* const bus, const uint16_t tick_us, const bool transmit) {
+
+    const SWI2CMaster* const master = bus->master;
+
+    if(bus->step == 0) {
+        bool level = 1; // released so the slave can drive it
+        if(bus->bit < 8 && transmit)
+            level = (bus->byte & (0x80 >> bus->bit)) != 0;
+        else if(bus->bit == 8 && !transmit)
+            level = (bus->index == bus->job->size - 1)? I2C_NACK: I2C_ACK;
+
+        sw_i2c_master_config(master)->scl_write(0);
+        sw_i2c_master_config(master)->sda_write(level);
+        wait(bus, tick_us, master->timing.low);
+        bus->step = 1;
+        return;
+    }
+
+    sw_i2c_master_config(master)->scl_write(1);
+    wait(bus, tick_us, master->timing.high);
+    bus->step = 0;
+
+    if(transmit && bus->bit < 8)
+        bus->bit++;
+    else
+        bus->sample = true;
+
+}
+
+// does the next edge of the frame, then leaves the time to wait before the one after in bus->wait
+static void step(SWI2CSchedulerBus* const bus, const uint16_t tick_us) {
+
+    SWI2CMaster* const master = bus->master;
+    SWI2CJob* const job = bus->job;
+
+    if(bus->sample) {
+        bus->sample = false;
+        sampled(bus, sw_i2c_master_config(master)->sda_read());
+    }
+
+    switch(segment(bus)) {
+
+        case SEG_START:
+            master->started = true;
+            sw_i2c_master_config(master)->sda_write(1);
+            sw_i2c_master_config(master)->sda_write(0);
+            wait(bus, tick_us, master->timing.hd_sta);
+            next_segment(bus);
+            break;
+
+        case SEG_RESTART:
+            if(bus->step == 0) {
+                sw_i2c_master_config(master)->scl_write(0);
+                sw_i2c_master_config(master)->sda_write(1);
+                wait(bus, tick_us, master->timing.low);
+            }
+            else if(bus->step == 1) {
+                sw_i2c_master_config(master)->scl_write(1);
+                wait(bus, tick_us, master->timing.su_sta);
+            }
+            else {
+                sw_i2c_master_config(master)->sda_write(0);
+                wait(bus, tick_us, master->timing.hd_sta);
+                next_segment(bus);
+                break;
+            }
+            bus->step++;
+            break;
+
+        case SEG_STOP:
+            if(bus->step == 0) {
+                sw_i2c_master_config(master)->scl_write(0);
+                sw_i2c_master_config(master)->sda_write(0);
+                wait(bus, tick_us, master->timing.low);
+            }
+            else if(bus->step == 1) {
+                sw_i2c_master_config(master)->scl_write(1);
+                wait(bus, tick_us, master->timing.su_sto);
+            }
+            else {
+                master->started = false;
+                sw_i2c_master_config(master)->sda_write(1);
+                wait(bus, tick_us, master->timing.buf);
+                next_segment(bus);
+                break;
+            }
+            bus->step++;
+            break;
+
+        case SEG_ADDR_W:
+        case SEG_ADDR_R:
+        case SEG_REG:
+            if(bus->bit == 0 && bus->step == 0) {
+                const uint8_t seg = segment(bus);
+                bus->byte = (seg == SEG_REG)? job->reg: (uint8_t)((job->address << 1) | (seg == SEG_ADDR_R));
+            }
+            clock(bus, tick_us, true);
+            break;
+
+        case SEG_TX:
+            if(bus->index == job->size) { // nothing to write
+                next_segment(bus);
+                step(bus, tick_us);
+                break;
+            }
+            if(bus->bit == 0 && bus->step == 0)
+                bus->byte = ((const uint8_t*)job->data)[bus->index];
+            clock(bus, tick_us, true);
+            break;
+
+        case SEG_RX:
+            if(bus->index == job->size) {
+                next_segment(bus);
+                step(bus, tick_us);
+                break;
+            }
+            clock(bus, tick_us, false);
+            break;
+
+        default: // SEG_DONE, the last wait is already over
+            bus->job = NULL;
+            job->busy = false;
+            break;
+
+    }
+
+}
+
+SWI2CScheduler* sw_i2c_scheduler_init(SWI2CScheduler* const scheduler, void (*delay)(const uint16_t useconds)) {
+
+    if(scheduler == NULL || delay == NULL)
+        return NULL;
+
+    scheduler->count = 0;
+    scheduler->tick_us = 0;
+    scheduler->delay = delay;
+
+    return scheduler;
+
+}
+
+int8_t sw_i2c_scheduler_add(SWI2CScheduler* const scheduler, SWI2CMaster* const master) {
+
+    if(master == NULL || scheduler->count == SW_I2C_SCHEDULER_MAX_BUSES)
+        return -1;
+
+    SWI2CSchedulerBus* const bus = &scheduler->buses[scheduler->count];
+    bus->master = master;
+    bus->job = NULL;
+    bus->wait = 0;
+    bus->sample = false;
+
+    // ticking at the common divisor of every phase keeps each bus at exactly its own timing
+    const SWI2CTiming* const t = &master->timing;
+    const uint16_t phases[] = { t->hd_sta, t->su_sta, t->su_sto, t->buf, t->low, t->high };
+    for(uint8_t i = 0; i < sizeof(phases) / sizeof(phases[0]); i++)
+        scheduler->tick_us = gcd(scheduler->tick_us, phases[i]);
+
+    return (int8_t)scheduler->count++;
+
+}
+
+bool sw_i2c_scheduler_submit(SWI2CScheduler* const scheduler, const uint8_t bus, SWI2CJob* const job) {
+
+    if(bus >= scheduler->count || job == NULL || (job->size != 0 && job->data == NULL))
+        return false;
+
+    // a read has to have a byte to NACK before the STOP
+    if((job->kind == SW_I2C_JOB_READ || job->kind == SW_I2C_JOB_READ_REG) && job->size == 0)
+        return false;
+
+    SWI2CSchedulerBus* const b = &scheduler->buses[bus];
+    if(b->job != NULL)
+        return false;
+
+    job->done = 0;
+    job->busy = true;
+
+    b->index = 0;
+    b->segment = 0;
+    b->step = 0;
+    b->bit = 0;
+    b->wait = 0;
+    b->sample = false;
+    b->job = job;
+
+    return true;
+
+}
+
+uint8_t sw_i2c_scheduler_poll(SWI2CScheduler* const scheduler) {
+
+    const uint16_t tick = scheduler->tick_us? scheduler->tick_us: 1;
+    uint16_t next = UINT16_MAX;
+    uint8_t busy = 0;
+
+    for(uint8_t i = 0; i < scheduler->count; i++) {
+
+        SWI2CSchedulerBus* const bus = &scheduler->buses[i];
+        while(bus->job != NULL && bus->wait == 0)
+            step(bus, tick);
+
+        if(bus->job == NULL)
+            continue;
+
+        busy++;
+        if(bus->wait < next)
+            next = bus->wait;
+
+    }
+
+    if(busy == 0)
+        return 0;
+
+    // sleep straight through to the earliest bus that is due
+    scheduler->delay((uint16_t)(next * tick));
+    for(uint8_t i = 0; i < scheduler->count; i++) {
+        if(scheduler->buses[i].job != NULL)
+            scheduler->buses[i].wait -= next;
+    }
+
+    return busy;
+
+}
+
+void sw_i2c_scheduler_run(SWI2CScheduler* const scheduler) {
+
+    while(sw_i2c_scheduler_poll(scheduler) != 0);
+
+}
+
+#endif
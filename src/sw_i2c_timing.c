@@ -0,0 +1,169 @@
+/**
+ * \file sw_i2c_timing.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "../include/sw_i2c_timing.h"
+
+#if SW_I2C_ENABLE_TIMING_CHECKER
+
+// UM10204 table 10, minimums in nanoseconds
+static const uint32_t spec_ns[SW_I2C_MODE_COUNT][SW_I2C_T_COUNT] = {
+    //  HD;STA  SU;STA  SU;DAT  HD;DAT  LOW     HIGH    SU;STO  BUF
+    {   4000,   4700,   250,    0,      4700,   4000,   4000,   4700 },    // Standard-mode
+    {   600,    600,    100,    0,      1300,   600,    600,    1300 },    // Fast-mode
+    {   260,    260,    50,     0,      500,    260,    260,    500  },    // Fast-mode Plus
+};
+
+uint32_t sw_i2c_timing_spec_ns(const SWI2CMode mode, const SWI2CTimingParam param) {
+
+    return spec_ns[mode][param];
+
+}
+
+static void sample(SWI2CTimingChecker* const checker, const SWI2CTimingParam param, const uint32_t t_ns) {
+
+    if(t_ns < checker->min_ns[param])
+        checker->min_ns[param] = t_ns;
+    checker->samples[param]++;
+
+}
+
+void sw_i2c_timing_checker_init(SWI2CTimingChecker* const checker, const bool scl, const bool sda) {
+
+    for(uint8_t i = 0; i < SW_I2C_T_COUNT; i++) {
+        checker->min_ns[i] = UINT32_MAX;
+        checker->samples[i] = 0;
+    }
+
+    checker->scl_rise = checker->scl_fall = checker->sda_change = 0;
+    checker->start = checker->stop = 0;
+
+    checker->scl = scl;
+    checker->sda = sda;
+    checker->busy = false;
+    checker->hold = false;
+    checker->stopped = false;
+    checker->clocked = false;
+    checker->data = false;
+
+}
+
+void sw_i2c_timing_checker_edge(SWI2CTimingChecker* const checker, const uint32_t t_ns, const bool scl, const bool sda) {
+
+    if(scl != checker->scl) {
+
+        if(scl) {
+            if(checker->busy && checker->clocked) {
+                sample(checker, SW_I2C_T_LOW, t_ns - checker->scl_fall);
+                if(checker->data)
+                    sample(checker, SW_I2C_T_SU_DAT, t_ns - checker->sda_change);
+            }
+            checker->scl_rise = t_ns;
+        }
+        else {
+            if(checker->hold)
+                sample(checker, SW_I2C_T_HD_STA, t_ns - checker->start);
+            else if(checker->busy && checker->clocked)
+                sample(checker, SW_I2C_T_HIGH, t_ns - checker->scl_rise);
+
+            checker->hold = false;
+            checker->clocked = checker->busy;
+            checker->data = false;
+            checker->scl_fall = t_ns;
+        }
+
+        checker->scl = scl;
+
+    }
+
+    if(sda != checker->sda) {
+
+        if(!checker->scl) {
+            if(checker->clocked)
+                sample(checker, SW_I2C_T_HD_DAT, t_ns - checker->scl_fall);
+            checker->sda_change = t_ns;
+            checker->data = true;
+        }
+        else if(!sda) { // start or repeated start
+            if(checker->busy)
+                sample(checker, SW_I2C_T_SU_STA, t_ns - checker->scl_rise);
+            else if(checker->stopped)
+                sample(checker, SW_I2C_T_BUF, t_ns - checker->stop);
+
+            checker->busy = true;
+            checker->hold = true;
+            checker->clocked = false;
+            checker->start = t_ns;
+        }
+        else { // stop
+            if(checker->busy)
+                sample(checker, SW_I2C_T_SU_STO, t_ns - checker->scl_rise);
+
+            checker->busy = false;
+            checker->stopped = true;
+            checker->clocked = false;
+            checker->stop = t_ns;
+        }
+
+        checker->sda = sda;
+
+    }
+
+}
+
+uint16_t sw_i2c_timing_checker_violations(const SWI2CTimingChecker* const checker, const SWI2CMode mode) {
+
+    uint16_t violations = 0;
+    for(uint8_t i = 0; i < SW_I2C_T_COUNT; i++) {
+        if(checker->samples[i] != 0 && checker->min_ns[i] < spec_ns[mode][i])
+            violations |= 1 << i;
+    }
+    return violations;
+
+}
+
+// how many nanoseconds the shortest observation of a parameter had to spare, negative if it was too short
+static int32_t slack_ns(const SWI2CTimingChecker* const checker, const SWI2CMode mode, const SWI2CTimingParam param) {
+
+    if(checker->samples[param] == 0)
+        return 0;
+
+    return (int32_t)checker->min_ns[param] - (int32_t)spec_ns[mode][param];
+
+}
+
+static uint16_t adjust(const uint16_t delay_us, const int32_t slack) {
+
+    if(slack < 0) // round what is missing up to the next microsecond
+        return delay_us + (uint16_t)((-slack + 999) / 1000);
+
+    const uint16_t spare = (uint16_t)(slack / 1000);
+    return spare > delay_us? 0: delay_us - spare;
+
+}
+
+void sw_i2c_timing_checker_suggest(const SWI2CTimingChecker* const checker, const SWI2CMode mode, const SWI2CTiming* const current, SWI2CTiming* const timing) {
+
+    // the low delay is both the clock low time and the data setup time, so it has to satisfy the tighter one
+    int32_t low = slack_ns(checker, mode, SW_I2C_T_LOW);
+    const int32_t su_dat = slack_ns(checker, mode, SW_I2C_T_SU_DAT);
+    if(checker->samples[SW_I2C_T_SU_DAT] != 0 && (checker->samples[SW_I2C_T_LOW] == 0 || su_dat < low))
+        low = su_dat;
+
+    timing->hd_sta = adjust(current->hd_sta, slack_ns(checker, mode, SW_I2C_T_HD_STA));
+    timing->su_sta = adjust(current->su_sta, slack_ns(checker, mode, SW_I2C_T_SU_STA));
+    timing->su_sto = adjust(current->su_sto, slack_ns(checker, mode, SW_I2C_T_SU_STO));
+    timing->buf = adjust(current->buf, slack_ns(checker, mode, SW_I2C_T_BUF));
+    timing->low = adjust(current->low, low);
+    timing->high = adjust(current->high, slack_ns(checker, mode, SW_I2C_T_HIGH));
+
+}
+
+#endif
@@ -0,0 +1,93 @@
+/**
+ * \file sw_i2c_trace.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief
+ * \version 0.1
+ * \date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "../include/sw_i2c_trace.h"
+
+#if SW_I2C_ENABLE_TRACE
+
+SWI2CTrace* sw_i2c_trace_init(SWI2CTrace* const trace, SWI2CTraceRecord* const records, const uint16_t capacity, uint32_t (*timestamp)(void)) {
+
+    if(trace == NULL || records == NULL || timestamp == NULL)
+        return NULL;
+
+    if(capacity == 0 || (capacity & (capacity - 1)) != 0)
+        return NULL;
+
+    trace->records = records;
+    trace->timestamp = timestamp;
+    trace->mask = capacity - 1;
+    atomic_init(&trace->head, 0);
+    atomic_init(&trace->tail, 0);
+    atomic_init(&trace->dropped, 0);
+
+    return trace;
+
+}
+
+bool sw_i2c_trace_pop(SWI2CTrace* const trace, SWI2CTraceRecord* const record) {
+
+    const uint16_t tail = atomic_load_explicit(&trace->tail, memory_order_relaxed); // only ever written here
+    if(tail == atomic_load_explicit(&trace->head, memory_order_acquire))
+        return false;
+
+    *record = trace->records[tail & trace->mask];
+    atomic_store_explicit(&trace->tail, (uint16_t)(tail + 1), memory_order_release);
+
+    return true;
+
+}
+
+uint16_t sw_i2c_trace_count(const SWI2CTrace* const trace) {
+
+    const uint16_t tail = atomic_load_explicit(&trace->tail, memory_order_acquire);
+    return (uint16_t)(atomic_load_explicit(&trace->head, memory_order_acquire) - tail);
+
+}
+
+static void put_le32(uint8_t* const buffer, const uint32_t value) {
+
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+
+}
+
+static uint32_t get_le32(const uint8_t* const buffer) {
+
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) | ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24);
+
+}
+
+void sw_i2c_trace_encode(const SWI2CTraceRecord* const record, uint8_t buffer[SW_I2C_TRACE_RECORD_SIZE]) {
+
+    put_le32(buffer, record->timestamp);
+    put_le32(buffer + 4, record->duration);
+    put_le32(buffer + 8, record->acks);
+    buffer[12] = (uint8_t)record->length;
+    buffer[13] = (uint8_t)(record->length >> 8);
+    buffer[14] = record->address;
+    buffer[15] = record->flags;
+
+}
+
+void sw_i2c_trace_decode(SWI2CTraceRecord* const record, const uint8_t buffer[SW_I2C_TRACE_RECORD_SIZE]) {
+
+    record->timestamp = get_le32(buffer);
+    record->duration = get_le32(buffer + 4);
+    record->acks = get_le32(buffer + 8);
+    record->length = (uint16_t)(buffer[12] | (buffer[13] << 8));
+    record->address = buffer[14];
+    record->flags = buffer[15];
+
+}
+
+#endif
@@ -14,6 +14,8 @@
 #include <driver/rtc_io.h>
 #include <esp_rom_sys.h>
 #include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #include <sw_i2c_master.h>
 
@@ -78,6 +80,13 @@ static bool read_scl() { return (bool)rtc_gpio_get_level(CONFIG_GPIO_SCL); }
 static void write_sda(const bool state) { rtc_gpio_set_level(CONFIG_GPIO_SDA, state); }
 static void write_scl(const bool state) { rtc_gpio_set_level(CONFIG_GPIO_SCL, state); }
 static void delay_us(const uint16_t us) { esp_rom_delay_us(us); }
+// rounds up to whole ticks straight from the tick rate, portTICK_PERIOD_MS is 0 above 1 kHz
+static void yield_us(const uint16_t us) {
+
+    const TickType_t ticks = (TickType_t)(((uint64_t)us * configTICK_RATE_HZ + 999999) / 1000000);
+    vTaskDelay(ticks? ticks: 1);
+
+}
 
 void i2c_init(SWI2CMaster* const master) {
 
@@ -90,16 +99,19 @@ void i2c_init(SWI2CMaster* const master) {
         .scl_read = read_scl,
         .sda_read = read_sda,
 
-        .delay = delay_us
+        .delay = delay_us,
+        .yield = yield_us
     };
 
     SWI2CMaster* res = sw_i2c_master_init(master, &config, CONFIG_I2C_FREQUENCY);
     TEST_ASSERT_MESSAGE(res != NULL, "I2C Master did Not COnfigure Correctly");
-    TEST_ASSERT_MESSAGE(res->config.sda_write == write_sda, "SDA Writing Function Isn't Correct");
-    TEST_ASSERT_MESSAGE(res->config.sda_read == read_sda, "SDA Reading Function isn't Correct");
-    TEST_ASSERT_MESSAGE(res->config.scl_write == write_scl, "SCL Writing Function Doesn't Line Up");
-    TEST_ASSERT_MESSAGE(res->config.scl_read == read_scl, "SCL Reading Function Doesn't Line Up");
+    TEST_ASSERT_MESSAGE(sw_i2c_master_config(res)->sda_write == write_sda, "SDA Writing Function Isn't Correct");
+    TEST_ASSERT_MESSAGE(sw_i2c_master_config(res)->sda_read == read_sda, "SDA Reading Function isn't Correct");
+    TEST_ASSERT_MESSAGE(sw_i2c_master_config(res)->scl_write == write_scl, "SCL Writing Function Doesn't Line Up");
+    TEST_ASSERT_MESSAGE(sw_i2c_master_config(res)->scl_read == read_scl, "SCL Reading Function Doesn't Line Up");
+#if !SW_I2C_PACKED
     TEST_ASSERT_MESSAGE(res->frequency == CONFIG_I2C_FREQUENCY, "I2C Frequency Wasn't the Same as Assigned");
+#endif
 
 }
 
@@ -0,0 +1,411 @@
+/**
+ * \file sw_i2c_sim.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief 
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <string.h>
+
+#include "sw_i2c_sim.h"
+
+typedef enum SimState { SIM_IDLE, SIM_ADDR, SIM_WRITE, SIM_READ } SimState;
+
+/// @brief A register based slave
+typedef struct SimSlave {
+
+    bool sda;                       ///< What the slave is driving, true is released
+    SimState state;
+    uint8_t bit;                    ///< Bits of the current byte clocked so far, 8 and 9 are the ACK slot
+    uint8_t shift;
+    bool reading;                   ///< The slave was addressed for a read
+    bool pointer;                   ///< The next written byte is the register pointer
+    bool acked;                     ///< The master ACKed the last byte read
+    bool present;
+    bool general_call;              ///< Writes to address 0 are taken as well
+    uint8_t address;
+    uint8_t reg;                    ///< The register pointer
+    bool increment;                 ///< Reads move the register pointer on
+    uint16_t read_only;             ///< Writes to this register and the ones after it are NACKed
+    uint16_t pending;               ///< Register that gets pending_value at pending_ns, SW_I2C_SIM_REGS if none
+    uint8_t pending_value;
+    uint32_t pending_ns;
+    uint8_t regs[SW_I2C_SIM_REGS];
+
+} SimSlave;
+
+/// @brief One bus and the slaves sitting on it
+typedef struct SimBus {
+
+    bool master_scl, master_sda;    ///< What the master is driving, true is released
+    bool scl, sda;                  ///< The resulting wired-and levels
+    bool stuck;                     ///< Something outside the slaves holds SDA low
+    uint32_t starts;
+
+    SimSlave slaves[SW_I2C_SIM_SLAVES];
+    uint8_t count;
+
+    SWI2CSimListener listener;
+    void* ctx;
+
+} SimBus;
+
+static SimBus buses[SW_I2C_SIM_BUSES];
+static uint32_t now_ns;
+static uint32_t gpio_ns;
+static uint32_t yield_ns;
+static uint32_t yields;
+
+static void slave_drive(SimSlave* const slave, const bool level) {
+
+    slave->sda = level;
+
+}
+
+static void slave_load(SimSlave* const slave) {
+
+    if(slave->pending < SW_I2C_SIM_REGS && now_ns >= slave->pending_ns) {
+        slave->regs[slave->pending] = slave->pending_value;
+        slave->pending = SW_I2C_SIM_REGS;
+    }
+
+    slave->shift = slave->regs[slave->reg];
+    if(slave->increment)
+        slave->reg++;
+    slave->bit = 0;
+    slave_drive(slave, (slave->shift & 0x80) != 0);
+
+}
+
+static void slave_scl_rise(SimSlave* const slave, const bool sda) {
+
+    if(slave->state == SIM_ADDR || slave->state == SIM_WRITE) {
+        if(slave->bit < 8)
+            slave->shift = (uint8_t)((slave->shift << 1) | sda);
+        slave->bit++;
+    }
+    else if(slave->state == SIM_READ) {
+        if(slave->bit == 8)
+            slave->acked = !sda;
+        slave->bit++;
+    }
+
+}
+
+static bool slave_addressed(const SimSlave* const slave) {
+
+    if(!slave->present)
+        return false;
+
+    if(slave->shift == 0) // general call, only ever a write
+        return slave->general_call;
+
+    return (slave->shift >> 1) == slave->address;
+
+}
+
+static void slave_scl_fall(SimSlave* const slave) {
+
+    switch(slave->state) {
+
+        case SIM_ADDR:
+            if(slave->bit == 8) {
+                if(!slave_addressed(slave)) {
+                    slave->state = SIM_IDLE;
+                    break;
+                }
+                slave->reading = slave->shift & 1;
+                slave_drive(slave, 0);
+            }
+            else if(slave->bit == 9) {
+                if(slave->reading) {
+                    slave->state = SIM_READ;
+                    slave_load(slave);
+                }
+                else {
+                    slave->state = SIM_WRITE;
+                    slave->pointer = true;
+                    slave->bit = 0;
+                    slave_drive(slave, 1);
+                }
+            }
+            break;
+
+        case SIM_WRITE:
+            if(slave->bit == 8) {
+                if(slave->pointer)
+                    slave->reg = slave->shift;
+                else if(slave->reg >= slave->read_only) {
+                    slave->state = SIM_IDLE; // NACK and ignore the rest
+                    break;
+                }
+                else
+                    slave->regs[slave->reg++] = slave->shift;
+                slave->pointer = false;
+                slave_drive(slave, 0);
+            }
+            else if(slave->bit == 9) {
+                slave->bit = 0;
+                slave_drive(slave, 1);
+            }
+            break;
+
+        case SIM_READ:
+            if(slave->bit < 8)
+                slave_drive(slave, (slave->shift & (0x80 >> slave->bit)) != 0);
+            else if(slave->bit == 8)
+                slave_drive(slave, 1);
+            else if(slave->acked)
+                slave_load(slave);
+            else
+                slave->state = SIM_IDLE;
+            break;
+
+        default:
+            break;
+
+    }
+
+}
+
+static bool wired_sda(const SimBus* const bus) {
+
+    bool sda = bus->master_sda && !bus->stuck;
+    for(uint8_t i = 0; i < bus->count; i++)
+        sda = sda && bus->slaves[i].sda;
+    return sda;
+
+}
+
+// works out the wired-and levels and lets the slaves react until nothing changes anymore
+static void update(SimBus* const bus) {
+
+    const bool scl = bus->master_scl;
+    bool sda = wired_sda(bus);
+
+    if(scl != bus->scl) {
+        bus->scl = scl;
+        if(bus->listener)
+            bus->listener(bus->ctx, now_ns, bus->scl, bus->sda);
+
+        for(uint8_t i = 0; i < bus->count; i++) {
+            if(scl)
+                slave_scl_rise(&bus->slaves[i], bus->sda);
+            else
+                slave_scl_fall(&bus->slaves[i]);
+        }
+
+        sda = wired_sda(bus);
+    }
+
+    if(sda != bus->sda) {
+        bus->sda = sda;
+        if(bus->listener)
+            bus->listener(bus->ctx, now_ns, bus->scl, bus->sda);
+
+        if(bus->scl) {
+            if(!sda)
+                bus->starts++;
+            for(uint8_t i = 0; i < bus->count; i++) {
+                SimSlave* const slave = &bus->slaves[i];
+                slave->state = sda? SIM_IDLE: SIM_ADDR;
+                slave->bit = 0;
+                slave_drive(slave, 1);
+            }
+        }
+    }
+
+}
+
+static void sim_sda_write(const uint8_t n, const bool state) {
+
+    now_ns += gpio_ns;
+    buses[n].master_sda = state;
+    update(&buses[n]);
+
+}
+
+static void sim_scl_write(const uint8_t n, const bool state) {
+
+    now_ns += gpio_ns;
+    buses[n].master_scl = state;
+    update(&buses[n]);
+
+}
+
+static bool sim_sda_read(const uint8_t n) {
+
+    now_ns += gpio_ns;
+    return buses[n].sda;
+
+}
+
+static bool sim_scl_read(const uint8_t n) {
+
+    now_ns += gpio_ns;
+    return buses[n].scl;
+
+}
+
+void sw_i2c_sim_port_write(const uint32_t mask, const uint32_t value) {
+
+    now_ns += gpio_ns;
+    for(uint8_t n = 0; n < SW_I2C_SIM_BUSES; n++) {
+        if(mask & SW_I2C_SIM_PORT_SCL(n))
+            buses[n].master_scl = (value & SW_I2C_SIM_PORT_SCL(n)) != 0;
+        if(mask & SW_I2C_SIM_PORT_SDA(n))
+            buses[n].master_sda = (value & SW_I2C_SIM_PORT_SDA(n)) != 0;
+        update(&buses[n]);
+    }
+
+}
+
+uint32_t sw_i2c_sim_port_read(void) {
+
+    now_ns += gpio_ns;
+    uint32_t port = 0;
+    for(uint8_t n = 0; n < SW_I2C_SIM_BUSES; n++) {
+        if(buses[n].scl)
+            port |= SW_I2C_SIM_PORT_SCL(n);
+        if(buses[n].sda)
+            port |= SW_I2C_SIM_PORT_SDA(n);
+    }
+    return port;
+
+}
+
+static void sim_delay(const uint16_t useconds) {
+
+    now_ns += (uint32_t)useconds * 1000;
+
+}
+
+// a yield hands the time to somebody else and comes back late by the scheduling overhead
+static void sim_yield(const uint16_t useconds) {
+
+    now_ns += (uint32_t)useconds * 1000 + yield_ns;
+    yields++;
+
+}
+
+// the config callbacks carry no context, so every bus gets its own set
+#define SIM_BUS(n) \
+    static void sda_write_##n(const bool state) { sim_sda_write(n, state); } \
+    static void scl_write_##n(const bool state) { sim_scl_write(n, state); } \
+    static bool sda_read_##n(void) { return sim_sda_read(n); } \
+    static bool scl_read_##n(void) { return sim_scl_read(n); }
+
+SIM_BUS(0) SIM_BUS(1) SIM_BUS(2) SIM_BUS(3) SIM_BUS(4) SIM_BUS(5) SIM_BUS(6) SIM_BUS(7)
+
+#define SIM_CONFIG(n) { .sda_write = sda_write_##n, .scl_write = scl_write_##n, .sda_read = sda_read_##n, .scl_read = scl_read_##n, .delay = sim_delay, .yield = sim_yield }
+
+static const SWI2CConfig configs[SW_I2C_SIM_BUSES] = {
+    SIM_CONFIG(0), SIM_CONFIG(1), SIM_CONFIG(2), SIM_CONFIG(3), SIM_CONFIG(4), SIM_CONFIG(5), SIM_CONFIG(6), SIM_CONFIG(7)
+};
+
+static void slave_reset(SimSlave* const slave, const uint8_t address) {
+
+    memset(slave, 0, sizeof(*slave));
+    slave->sda = true;
+    slave->present = true;
+    slave->increment = true;
+    slave->read_only = SW_I2C_SIM_REGS;
+    slave->address = address;
+    slave->pending = SW_I2C_SIM_REGS;
+
+}
+
+void sw_i2c_sim_reset(const uint8_t address) {
+
+    memset(buses, 0, sizeof(buses));
+    for(uint8_t i = 0; i < SW_I2C_SIM_BUSES; i++) {
+        buses[i].master_scl = buses[i].master_sda = true;
+        buses[i].scl = buses[i].sda = true;
+        buses[i].count = 1;
+        slave_reset(&buses[i].slaves[0], address);
+    }
+
+    now_ns = 0;
+    gpio_ns = 0;
+    yield_ns = 0;
+    yields = 0;
+
+}
+
+uint8_t sw_i2c_sim_add_slave(const uint8_t bus, const uint8_t address) {
+
+    SimBus* const b = &buses[bus];
+    if(b->count == SW_I2C_SIM_SLAVES)
+        return SW_I2C_SIM_SLAVES;
+
+    slave_reset(&b->slaves[b->count], address);
+    return b->count++;
+
+}
+
+const SWI2CConfig* sw_i2c_sim_config(const uint8_t bus) { return &configs[bus]; }
+
+void sw_i2c_sim_set_gpio_cost(const uint32_t ns) { gpio_ns = ns; }
+
+void sw_i2c_sim_set_yield_overshoot(const uint32_t ns) { yield_ns = ns; }
+
+uint32_t sw_i2c_sim_yields(void) { return yields; }
+
+uint32_t sw_i2c_sim_time_ns(void) { return now_ns; }
+
+void sw_i2c_sim_listen(const uint8_t bus, const SWI2CSimListener listener, void* const ctx) {
+
+    buses[bus].listener = listener;
+    buses[bus].ctx = ctx;
+
+}
+
+#if SW_I2C_ENABLE_TIMING_CHECKER
+
+static void sw_i2c_sim_timing_edge(void* const ctx, const uint32_t t_ns, const bool scl, const bool sda) {
+
+    sw_i2c_timing_checker_edge((SWI2CTimingChecker*)ctx, t_ns, scl, sda);
+
+}
+
+void sw_i2c_sim_check_timing(const uint8_t bus, SWI2CTimingChecker* const checker) {
+
+    sw_i2c_sim_listen(bus, checker? sw_i2c_sim_timing_edge: NULL, checker);
+
+}
+
+#endif
+
+uint8_t* sw_i2c_sim_registers(const uint8_t bus) { return buses[bus].slaves[0].regs; }
+
+uint8_t* sw_i2c_sim_slave_registers(const uint8_t bus, const uint8_t slave) { return buses[bus].slaves[slave].regs; }
+
+void sw_i2c_sim_set_present(const uint8_t bus, const bool present) { buses[bus].slaves[0].present = present; }
+
+void sw_i2c_sim_set_general_call(const uint8_t bus, const uint8_t slave, const bool enable) { buses[bus].slaves[slave].general_call = enable; }
+
+uint32_t sw_i2c_sim_starts(const uint8_t bus) { return buses[bus].starts; }
+
+void sw_i2c_sim_set_increment(const uint8_t bus, const bool increment) { buses[bus].slaves[0].increment = increment; }
+
+void sw_i2c_sim_write_at(const uint8_t bus, const uint8_t reg, const uint8_t value, const uint32_t t_ns) {
+
+    SimSlave* const slave = &buses[bus].slaves[0];
+    slave->pending = reg;
+    slave->pending_value = value;
+    slave->pending_ns = t_ns;
+
+}
+
+void sw_i2c_sim_set_read_only(const uint8_t bus, const uint16_t from) { buses[bus].slaves[0].read_only = from; }
+
+void sw_i2c_sim_set_stuck(const uint8_t bus, const bool stuck) {
+
+    buses[bus].stuck = stuck;
+    update(&buses[bus]);
+
+}
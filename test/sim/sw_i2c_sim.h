@@ -0,0 +1,197 @@
+/**
+ * \file sw_i2c_sim.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Simulated open drain buses with register based slaves, for running the library on a host
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ * Time is virtual: it only moves forward when a delay is called or a GPIO is touched, 
+ * so every edge can be timestamped exactly
+ * 
+ */
+
+#ifndef SW_I2C_SIM_H
+#define SW_I2C_SIM_H
+
+#include <sw_i2c.h>
+#if SW_I2C_ENABLE_TIMING_CHECKER
+#include <sw_i2c_timing.h>
+#endif
+
+#define SW_I2C_SIM_BUSES 8      ///< How many independent buses are simulated
+#define SW_I2C_SIM_REGS  256    ///< Size of the register file of each slave
+#define SW_I2C_SIM_SLAVES 4     ///< How many slaves can share one bus
+
+#define SW_I2C_SIM_PORT_SCL(n) ((uint32_t)1 << (2 * (n)))        ///< The port pin wired to the SCL of bus n
+#define SW_I2C_SIM_PORT_SDA(n) ((uint32_t)1 << (2 * (n) + 1))    ///< The port pin wired to the SDA of bus n
+
+/// @brief Gets told about every change of the bus lines
+typedef void (*SWI2CSimListener)(void* const ctx, const uint32_t t_ns, const bool scl, const bool sda);
+
+/**
+ * \brief Releases every bus and leaves a single slave with cleared registers on each, at address
+ * 
+ * \param[in] address: The 7 bit address the slaves answer to
+ */
+void sw_i2c_sim_reset(const uint8_t address);
+
+/**
+ * \brief Puts another slave on a bus, the first one is the one sw_i2c_sim_reset put there
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] address: The 7 bit address the slave answers to
+ * \return uint8_t: The index of the slave on the bus, SW_I2C_SIM_SLAVES if the bus is full
+ */
+uint8_t sw_i2c_sim_add_slave(const uint8_t bus, const uint8_t address);
+
+/**
+ * \brief The callbacks for driving one of the simulated buses
+ * 
+ * \param[in] bus: Which bus, less than SW_I2C_SIM_BUSES
+ * \return const SWI2CConfig*: The Config to hand to sw_i2c_master_init
+ */
+const SWI2CConfig* sw_i2c_sim_config(const uint8_t bus);
+
+/**
+ * \brief Drives the pins of every bus at once, as if they were all on one GPIO port
+ * 
+ * \param[in] mask: The Pins to Change, see SW_I2C_SIM_PORT_SCL and SW_I2C_SIM_PORT_SDA
+ * \param[in] value: The Levels to put on them
+ */
+void sw_i2c_sim_port_write(const uint32_t mask, const uint32_t value);
+
+/**
+ * \brief Reads the lines of every bus at once
+ * 
+ * \return uint32_t: The Level of every port pin
+ */
+uint32_t sw_i2c_sim_port_read(void);
+
+/**
+ * \brief Sets how long a simulated GPIO access takes, 0 by default
+ * 
+ * \param[in] ns: Nanoseconds per GPIO read or write
+ */
+void sw_i2c_sim_set_gpio_cost(const uint32_t ns);
+
+/**
+ * \brief Sets how late a yield comes back, 0 by default
+ * 
+ * \param[in] ns: Nanoseconds every yield overshoots by
+ */
+void sw_i2c_sim_set_yield_overshoot(const uint32_t ns);
+
+/**
+ * \brief How many times the buses yielded instead of spinning
+ * 
+ * \return uint32_t: The number of yields since the last reset
+ */
+uint32_t sw_i2c_sim_yields(void);
+
+/**
+ * \brief The current virtual time
+ * 
+ * \return uint32_t: Nanoseconds since the last reset
+ */
+uint32_t sw_i2c_sim_time_ns(void);
+
+/**
+ * \brief Lets a listener watch a bus, NULL to stop watching
+ * 
+ * \param[in] bus: Which bus to watch
+ * \param[in] listener: Who to tell
+ * \param[in] ctx: Handed back to the listener
+ */
+void sw_i2c_sim_listen(const uint8_t bus, const SWI2CSimListener listener, void* const ctx);
+
+#if SW_I2C_ENABLE_TIMING_CHECKER
+
+/**
+ * \brief Feeds every edge of a bus to a timing checker, it takes the place of any other listener
+ * 
+ * \param[in] bus: Which bus to check
+ * \param[in] checker: An Initialized Checker, NULL to stop checking
+ */
+void sw_i2c_sim_check_timing(const uint8_t bus, SWI2CTimingChecker* const checker);
+
+#endif
+
+/**
+ * \brief The register file of the first slave on a bus
+ * 
+ * \param[in] bus: Which bus
+ * \return uint8_t*: SW_I2C_SIM_REGS registers
+ */
+uint8_t* sw_i2c_sim_registers(const uint8_t bus);
+
+/**
+ * \brief The register file of any slave on a bus
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] slave: Which slave, as returned by sw_i2c_sim_add_slave
+ * \return uint8_t*: SW_I2C_SIM_REGS registers
+ */
+uint8_t* sw_i2c_sim_slave_registers(const uint8_t bus, const uint8_t slave);
+
+/**
+ * \brief Lets a slave take writes to the general call address as if they were addressed to it
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] slave: Which slave
+ * \param[in] enable: If the slave answers the general call, false by default
+ */
+void sw_i2c_sim_set_general_call(const uint8_t bus, const uint8_t slave, const bool enable);
+
+/**
+ * \brief Detaches the first slave on a bus so it NACKs everything
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] present: If the slave answers
+ */
+void sw_i2c_sim_set_present(const uint8_t bus, const bool present);
+
+/**
+ * \brief How many start conditions (including repeated ones) a bus has seen
+ * 
+ * \param[in] bus: Which bus
+ * \return uint32_t: The number of starts since the last reset
+ */
+uint32_t sw_i2c_sim_starts(const uint8_t bus);
+
+/**
+ * \brief Makes the first slave on a bus send the same register on every byte of a read, like most status registers
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] increment: If reads move the register pointer on, true by default
+ */
+void sw_i2c_sim_set_increment(const uint8_t bus, const bool increment);
+
+/**
+ * \brief Changes a register of the first slave once the virtual time reaches t_ns, like a conversion finishing
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] reg: The Register to change
+ * \param[in] value: Its new value
+ * \param[in] t_ns: When it changes
+ */
+void sw_i2c_sim_write_at(const uint8_t bus, const uint8_t reg, const uint8_t value, const uint32_t t_ns);
+
+/**
+ * \brief Write protects the registers of the first slave on a bus from a register on, writes to them are NACKed
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] from: The first read only register, SW_I2C_SIM_REGS for none which is the default
+ */
+void sw_i2c_sim_set_read_only(const uint8_t bus, const uint16_t from);
+
+/**
+ * \brief Holds SDA of a bus low from outside, like a slave that lost track of the clock
+ * 
+ * \param[in] bus: Which bus
+ * \param[in] stuck: If SDA is held low
+ */
+void sw_i2c_sim_set_stuck(const uint8_t bus, const bool stuck);
+
+#endif
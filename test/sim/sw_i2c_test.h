@@ -0,0 +1,34 @@
+/**
+ * \file sw_i2c_test.h
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief The checks every host test shares, include it once from the test's only source file
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#ifndef SW_I2C_TEST_H
+#define SW_I2C_TEST_H
+
+#include <stdio.h>
+
+static int failures = 0;    ///< How many checks failed so far
+
+/// @brief Counts and reports a failed check, the test goes on either way
+#define CHECK(cond, msg) do { if(!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); failures++; } } while(0)
+
+/**
+ * \brief Prints the verdict of the test
+ * 
+ * \return int: What main returns, 0 if every check passed
+ */
+static inline int sw_i2c_test_result(void) {
+
+    printf("%s\n", failures? "FAILED": "OK");
+    return failures != 0;
+
+}
+
+#endif
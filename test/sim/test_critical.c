@@ -0,0 +1,147 @@
+/**
+ * \file test_critical.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Runs transactions on the simulated bus with critical sections per bit, byte and transaction and checks what gets masked
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sw_i2c_master.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+
+static int depth, deepest;
+static uint32_t enters, exits;
+static uint32_t yields_on_enter;
+static bool yielded_inside;
+
+static uint32_t now_us(void) { return sw_i2c_sim_time_ns() / 1000; }
+
+static void enter(void) {
+
+    enters++;
+    if(++depth > deepest)
+        deepest = depth;
+    yields_on_enter = sw_i2c_sim_yields();
+
+}
+
+static void leave(void) {
+
+    exits++;
+    depth--;
+    if(sw_i2c_sim_yields() != yields_on_enter)
+        yielded_inside = true;
+
+}
+
+static SWI2CConfig config;  // the master may only point to it
+
+static void setup(SWI2CMaster* const master, SWI2CCritical* const critical, const SWI2CCriticalLevel level) {
+
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    config = *sw_i2c_sim_config(0);
+    config.critical_enter = enter;
+    config.critical_exit = leave;
+    depth = deepest = 0;
+    enters = exits = 0;
+    yielded_inside = false;
+
+    sw_i2c_master_init(master, &config, 1000);
+    sw_i2c_master_set_yield_threshold(master, 1); // every wait would yield if it were allowed to
+    sw_i2c_critical_init(critical, level, now_us);
+    CHECK(sw_i2c_master_critical_attach(master, critical), "attach");
+
+}
+
+// a register write and read back, 9 bytes and 81 clocks in two transactions
+static SWI2CCritical run(const SWI2CCriticalLevel level) {
+
+    SWI2CMaster master;
+    SWI2CCritical critical;
+
+    setup(&master, &critical, level);
+
+    const uint8_t out[2] = { 0xa5, 0x5a };
+    uint8_t in[2] = { 0 };
+    CHECK(sw_i2c_master_write_reg(&master, SLAVE_ADDRESS, 0x10, out, sizeof(out)) == sizeof(out), "write");
+    CHECK(sw_i2c_master_read_reg(&master, SLAVE_ADDRESS, 0x10, in, sizeof(in)) == sizeof(in), "read");
+    CHECK(memcmp(in, out, sizeof(in)) == 0, "read back the wrong data");
+
+    CHECK(depth == 0 && !critical.masked, "every section should be left again");
+    CHECK(deepest <= 1, "sections should never nest");
+    CHECK(!yielded_inside, "a masked master must not yield");
+
+    printf("level %d: %3u sections, longest %5u us, %u yields\n", (int)level, (unsigned)critical.sections, (unsigned)critical.longest_us, (unsigned)sw_i2c_sim_yields());
+    return critical;
+
+}
+
+// transactions that end early on a NACK of the address, of the read address and of the data
+static SWI2CCritical nack(const SWI2CCriticalLevel level) {
+
+    SWI2CMaster master;
+    SWI2CCritical critical;
+
+    setup(&master, &critical, level);
+    sw_i2c_sim_set_read_only(0, 0x10);
+
+    const uint8_t out[2] = { 0xa5, 0x5a };
+    uint8_t in[2] = { 0 };
+    CHECK(sw_i2c_master_write_reg(&master, SLAVE_ADDRESS + 1, 0x10, out, sizeof(out)) == 0, "write to a missing slave");
+    CHECK(sw_i2c_master_read_reg(&master, SLAVE_ADDRESS + 1, 0x10, in, sizeof(in)) == 0, "read from a missing slave");
+    CHECK(sw_i2c_master_write_reg(&master, SLAVE_ADDRESS, 0x10, out, sizeof(out)) == 0, "write to a read only register");
+
+    CHECK(enters == exits, "every section entered should be left after a NACK");
+    CHECK(depth == 0 && !critical.masked, "a NACK should not leave the master masked");
+    CHECK(!master.started, "a NACK should stop the bus");
+    CHECK(!yielded_inside, "a masked master must not yield");
+    return critical;
+
+}
+
+int main(void) {
+
+    const uint32_t period_us = 100;  // 1000 gives 50us low and high
+
+    CHECK(run(SW_I2C_CRITICAL_NONE).sections == 0, "nothing should be masked");
+
+    const SWI2CCritical bit = run(SW_I2C_CRITICAL_BIT);
+    CHECK(bit.sections == 81, "one section per clock");
+    CHECK(bit.longest_us == period_us, "a bit section should only cover its own clock");
+
+    const SWI2CCritical byte = run(SW_I2C_CRITICAL_BYTE);
+    CHECK(byte.sections == 9, "one section per byte");
+    CHECK(byte.longest_us == 9 * period_us, "a byte section should cover the 8 bits and the ACK");
+
+    const SWI2CCritical transaction = run(SW_I2C_CRITICAL_TRANSACTION);
+    CHECK(transaction.sections == 2, "one section per transaction");
+    CHECK(transaction.longest_us > 5 * 9 * period_us, "the read should be masked from start to stop");
+    CHECK(sw_i2c_sim_yields() != 0, "the bus free time after the stop can still yield");
+
+    const SWI2CCritical nack_bit = nack(SW_I2C_CRITICAL_BIT);
+    CHECK(nack_bit.sections != 0 && nack_bit.sections == enters, "bit sections around a NACK");
+    const SWI2CCritical nack_byte = nack(SW_I2C_CRITICAL_BYTE);
+    CHECK(nack_byte.sections != 0 && nack_byte.sections == enters, "byte sections around a NACK");
+    CHECK(nack(SW_I2C_CRITICAL_TRANSACTION).sections == 3, "one section per transaction, even if it fails");
+
+    // a config without the hooks can't be set up for it
+    SWI2CMaster master;
+    SWI2CCritical critical;
+    sw_i2c_master_init(&master, sw_i2c_sim_config(0), 1000);
+    sw_i2c_critical_init(&critical, SW_I2C_CRITICAL_BIT, NULL);
+    CHECK(!sw_i2c_master_critical_attach(&master, &critical), "attach without hooks");
+    CHECK(sw_i2c_master_critical_attach(&master, NULL), "detach");
+
+    return sw_i2c_test_result();
+
+}
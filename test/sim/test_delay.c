@@ -0,0 +1,70 @@
+/**
+ * \file test_delay.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Calibrates the spin/yield threshold on the simulated bus and checks that yielding keeps the bus in spec
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sw_i2c_master.h>
+#include <sw_i2c_timing.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+
+static uint32_t now_us(void) { return sw_i2c_sim_time_ns() / 1000; }
+
+int main(void) {
+
+    SWI2CMaster master;
+    SWI2CTimingChecker checker;
+
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_sim_set_yield_overshoot(150000); // a context switch that comes back 150us late
+    sw_i2c_master_init(&master, sw_i2c_sim_config(0), 100); // a slow bus, 500us per half period
+
+    CHECK(master.yield_threshold_us == UINT16_MAX, "masters should spin until told otherwise");
+    const uint32_t spun = sw_i2c_sim_yields();
+    sw_i2c_master_delay(&master, UINT16_MAX);
+    CHECK(sw_i2c_sim_yields() == spun, "even the longest wait should spin on a new master");
+    const uint16_t threshold = sw_i2c_master_calibrate_yield(&master, now_us);
+    printf("yield threshold %u us\n", threshold);
+    CHECK(threshold == 150 * SW_I2C_YIELD_FACTOR, "the threshold should follow the overshoot");
+
+    sw_i2c_timing_checker_init(&checker, true, true);
+    sw_i2c_sim_check_timing(0, &checker);
+    const uint32_t yields = sw_i2c_sim_yields();
+
+    const uint8_t out[3] = { 0x12, 0x34, 0x56 };
+    uint8_t in[3] = { 0 };
+    CHECK(sw_i2c_master_write_reg(&master, SLAVE_ADDRESS, 0x40, out, sizeof(out)) == sizeof(out), "write");
+    CHECK(sw_i2c_master_read_reg(&master, SLAVE_ADDRESS, 0x40, in, sizeof(in)) == sizeof(in), "read");
+    CHECK(memcmp(in, out, sizeof(in)) == 0, "read back the wrong data");
+
+    // every clock phase yields, the 5us start and stop phases are too short and spin
+    const uint32_t clocks = (1 + 1 + 3) * 9 + (1 + 1 + 1 + 3) * 9;
+    printf("%u yields for %u clocks\n", (unsigned)(sw_i2c_sim_yields() - yields), (unsigned)clocks);
+    CHECK(sw_i2c_sim_yields() - yields >= 2 * clocks, "the clock phases should have yielded");
+
+    CHECK(sw_i2c_timing_checker_violations(&checker, SW_I2C_MODE_STANDARD) == 0, "yielding broke the bus timing");
+    CHECK(checker.min_ns[SW_I2C_T_HD_STA] < 10000, "the short phases should still spin");
+
+    // a fast bus never gets near the threshold
+    sw_i2c_master_deinit(&master);
+    sw_i2c_master_init(&master, sw_i2c_sim_config(0), 10000);
+    sw_i2c_master_set_yield_threshold(&master, threshold);
+    const uint32_t before = sw_i2c_sim_yields();
+    CHECK(sw_i2c_master_read_reg(&master, SLAVE_ADDRESS, 0x40, in, sizeof(in)) == sizeof(in), "read on the fast bus");
+    CHECK(sw_i2c_sim_yields() == before, "a fast bus should only spin");
+
+    return sw_i2c_test_result();
+
+}
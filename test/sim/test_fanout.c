@@ -0,0 +1,101 @@
+/**
+ * \file test_fanout.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Pushes one configuration to several slaves on the simulated bus, by general call and by fan-out, and verifies it
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sw_i2c_master.h>
+#include <sw_i2c_timing.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define CONFIG_REG 0x20
+
+static const uint8_t addresses[] = { 0x40, 0x41, 0x42, 0x43 };   // nobody sits at 0x42
+static const uint8_t config[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10 };
+
+// slaves 0, 1 and 2 of the bus sit at 0x40, 0x41 and 0x43
+static void setup(SWI2CMaster* const master) {
+
+    sw_i2c_sim_reset(addresses[0]);
+    sw_i2c_sim_add_slave(0, addresses[1]);
+    sw_i2c_sim_add_slave(0, addresses[3]);
+    sw_i2c_master_init(master, sw_i2c_sim_config(0), 1000);
+
+}
+
+static bool configured(const uint8_t slave) {
+
+    return memcmp(sw_i2c_sim_slave_registers(0, slave) + CONFIG_REG, config, sizeof(config)) == 0;
+
+}
+
+int main(void) {
+
+    SWI2CMaster master;
+    SWI2CTimingChecker checker;
+
+    // one write_reg per slave, the way drivers do it today
+    setup(&master);
+    for(uint8_t i = 0; i < sizeof(addresses); i++)
+        sw_i2c_master_write_reg(&master, addresses[i], CONFIG_REG, config, sizeof(config));
+    const uint32_t loop_ns = sw_i2c_sim_time_ns();
+
+    // one transaction for all of them
+    setup(&master);
+    sw_i2c_timing_checker_init(&checker, true, true);
+    sw_i2c_sim_check_timing(0, &checker);
+    const uint32_t acked = sw_i2c_master_fanout_reg(&master, addresses, sizeof(addresses), CONFIG_REG, config, sizeof(config));
+    const uint32_t fanout_ns = sw_i2c_sim_time_ns();
+    CHECK(acked == 0xb, "only the slaves that are there should ACK");
+    CHECK(configured(0) && configured(1) && configured(2), "every slave should hold the config");
+    CHECK(sw_i2c_sim_starts(0) == sizeof(addresses), "one start per target");
+    CHECK(!master.started, "the bus should be stopped");
+    CHECK(sw_i2c_timing_checker_violations(&checker, SW_I2C_MODE_STANDARD) == 0, "the fan-out broke the bus timing");
+    sw_i2c_sim_check_timing(0, NULL);
+
+    // a repeated start costs about what a STOP and START do, so the fan-out is no faster, only never interleaved
+    printf("write_reg loop: %u us, fan-out: %u us\n", (unsigned)(loop_ns / 1000), (unsigned)(fanout_ns / 1000));
+    CHECK(fanout_ns <= loop_ns, "the fan-out should not take longer than the loop");
+
+    // the read-back stops at the first byte that differs
+    CHECK(sw_i2c_master_fanout_verify(&master, addresses, sizeof(addresses), CONFIG_REG, config, sizeof(config)) == 0xb, "verify");
+    sw_i2c_sim_slave_registers(0, 1)[CONFIG_REG + 1] ^= 0x01;
+    const uint32_t before = sw_i2c_sim_time_ns();
+    CHECK(sw_i2c_master_fanout_verify(&master, addresses, sizeof(addresses), CONFIG_REG, config, sizeof(config)) == 0x9, "verify should catch the corrupted slave");
+    CHECK(sw_i2c_sim_time_ns() - before < fanout_ns, "a mismatch should not be read to the end");
+    CHECK(!master.started, "the bus should be stopped after verifying");
+
+    // the general call only reaches the slaves that take it
+    setup(&master);
+    sw_i2c_sim_set_general_call(0, 0, true);
+    sw_i2c_sim_set_general_call(0, 2, true);
+    CHECK(sw_i2c_master_broadcast_reg(&master, CONFIG_REG, config, sizeof(config)) == sizeof(config), "broadcast");
+    CHECK(configured(0) && !configured(1) && configured(2), "only the general call slaves should be configured");
+    CHECK(sw_i2c_sim_starts(0) == 1, "a broadcast is a single transaction");
+    printf("broadcast: %u us\n", (unsigned)(sw_i2c_sim_time_ns() / 1000));
+    CHECK(sw_i2c_sim_time_ns() < loop_ns / 2, "a broadcast should stream the payload once");
+
+    // the bytes that mean something else after a general call never reach the bus
+    setup(&master);
+    sw_i2c_sim_set_general_call(0, 0, true);
+    CHECK(sw_i2c_master_broadcast_reg(&master, 0x00, config, sizeof(config)) == 0, "a broadcast to 0x00 should be refused");
+    CHECK(sw_i2c_master_broadcast_reg(&master, CONFIG_REG + 1, config, sizeof(config)) == 0, "a broadcast to an odd register should be refused");
+    CHECK(sw_i2c_master_broadcast_reg(&master, 0x04, config, sizeof(config)) == 0, "a broadcast that latches the address should be refused");
+    CHECK(sw_i2c_master_broadcast_reg(&master, 0x06, config, sizeof(config)) == 0, "a broadcast that resets should be refused");
+    CHECK(sw_i2c_sim_starts(0) == 0 && !configured(0), "a refused broadcast should not touch the bus");
+
+    CHECK(sw_i2c_master_fanout_reg(&master, addresses, 0, CONFIG_REG, config, sizeof(config)) == 0, "an empty fan-out");
+
+    return sw_i2c_test_result();
+
+}
@@ -0,0 +1,100 @@
+/**
+ * \file test_lanes.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Drives the simulated buses as bit-sliced lanes of one port and compares them against the blocking master
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <sw_i2c_lanes.h>
+#include <sw_i2c_timing.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+#define LANES SW_I2C_SIM_BUSES
+#define SIZE 6
+
+int main(void) {
+
+    uint8_t out[LANES][SIZE], in[LANES][SIZE];
+    for(uint8_t l = 0; l < LANES; l++) {
+        for(uint8_t i = 0; i < SIZE; i++)
+            out[l][i] = (uint8_t)(0x5a ^ (l * 16 + i));
+    }
+
+    // the reference, one bus after the other with the blocking master
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_sim_set_gpio_cost(100);
+    uint32_t start = sw_i2c_sim_time_ns();
+    for(uint8_t l = 0; l < LANES; l++) {
+        SWI2CMaster master;
+        sw_i2c_master_init(&master, sw_i2c_sim_config(l), 10000);
+        sw_i2c_master_write_reg(&master, SLAVE_ADDRESS, 0x30, out[l], SIZE);
+        sw_i2c_master_read_reg(&master, SLAVE_ADDRESS, 0x30, in[l], SIZE);
+    }
+    const uint32_t sequential = sw_i2c_sim_time_ns() - start;
+
+    // the same work on every lane at once, with the slave of lane 3 missing
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_sim_set_gpio_cost(100);
+    sw_i2c_sim_set_present(3, false);
+
+    SWI2CTimingChecker checker;
+    sw_i2c_timing_checker_init(&checker, true, true);
+    sw_i2c_sim_check_timing(0, &checker);
+
+    const SWI2CPortConfig port = { .port_write = sw_i2c_sim_port_write, .port_read = sw_i2c_sim_port_read, .delay = sw_i2c_sim_config(0)->delay };
+    uint32_t scl = 0, sda[LANES];
+    for(uint8_t l = 0; l < LANES; l++) {
+        scl |= SW_I2C_SIM_PORT_SCL(l);
+        sda[l] = SW_I2C_SIM_PORT_SDA(l);
+    }
+
+    SWI2CLanes lanes;
+    CHECK(sw_i2c_lanes_init(&lanes, &port, scl, sda, LANES, 10000) != NULL, "lanes init");
+    CHECK(sw_i2c_lanes_init(&lanes, &port, scl, sda, SW_I2C_LANES_MAX + 1, 10000) == NULL, "too many lanes");
+    CHECK(sw_i2c_lanes_init(&lanes, &port, scl, sda, LANES, 60000) == NULL, "a period below 2us has no clock delays left");
+    sda[1] = sda[0];
+    SWI2CLanes shared;
+    CHECK(sw_i2c_lanes_init(&shared, &port, scl, sda, LANES, 10000) == NULL, "lanes can't share an SDA pin");
+
+    const uint32_t expected = ((1u << LANES) - 1) & ~(1u << 3);
+    memset(in, 0, sizeof(in));
+    start = sw_i2c_sim_time_ns();
+    CHECK(sw_i2c_lanes_write_reg(&lanes, SLAVE_ADDRESS, 0x30, out, SIZE) == expected, "write ACK mask");
+    CHECK(sw_i2c_lanes_read_reg(&lanes, SLAVE_ADDRESS, 0x30, in, SIZE) == expected, "read ACK mask");
+    const uint32_t parallel = sw_i2c_sim_time_ns() - start;
+
+    for(uint8_t l = 0; l < LANES; l++) {
+        if(l == 3)
+            CHECK(in[l][0] == 0xff, "the missing slave should read as released");
+        else
+            CHECK(memcmp(in[l], out[l], SIZE) == 0, "read back the wrong data");
+    }
+
+    // the single byte calls have the same ACK semantics as the master
+    uint8_t bytes[LANES];
+    sw_i2c_lanes_start(&lanes);
+    memset(bytes, SLAVE_ADDRESS << 1 | 1, sizeof(bytes));
+    CHECK(sw_i2c_lanes_write_byte(&lanes, bytes) == expected, "addressing for a read");
+    CHECK(sw_i2c_lanes_read_byte(&lanes, bytes, 0) == ((1u << LANES) - 1), "NACKing the byte");
+    CHECK(bytes[0] == 0 && bytes[3] == 0xff, "the register after the ones written is still clear");
+    sw_i2c_lanes_stop(&lanes);
+
+    CHECK(sw_i2c_timing_checker_violations(&checker, SW_I2C_MODE_STANDARD) == 0, "the lanes broke the bus timing");
+
+    printf("%u lanes: sequential %" PRIu32 " us, parallel %" PRIu32 " us\n", LANES, sequential / 1000, parallel / 1000);
+    CHECK(parallel * 4 < sequential, "the lanes should be several times faster than the buses one by one");
+
+    return sw_i2c_test_result();
+
+}
@@ -0,0 +1,108 @@
+/**
+ * \file test_poller.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Polls registers of a simulated slave and checks the ordering, the merging and the deadline statistics
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sw_i2c_poller.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+
+static uint32_t now_us(void) { return sw_i2c_sim_time_ns() / 1000; }
+
+static SWI2CPollJob* order[8];
+static uint8_t finished = 0;
+
+static void done(SWI2CPollJob* const job, const bool ok) {
+
+    (void)ok;
+    if(finished < 8)
+        order[finished++] = job;
+
+}
+
+int main(void) {
+
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    uint8_t* const regs = sw_i2c_sim_registers(0);
+    for(uint16_t i = 0; i < SW_I2C_SIM_REGS; i++)
+        regs[i] = (uint8_t)(i ^ 0xa5);
+
+    SWI2CMaster master;
+    sw_i2c_master_init(&master, sw_i2c_sim_config(0), 10000);
+
+    uint8_t a[2], b[2], c[4], d[1], e[1];
+    SWI2CPollJob ja = { .address = SLAVE_ADDRESS, .reg = 0x10, .size = 2, .data = a, .period = 10000, .deadline = 5000, .done = done };
+    SWI2CPollJob jb = { .address = SLAVE_ADDRESS, .reg = 0x12, .size = 2, .data = b, .period = 10000, .deadline = 5000, .done = done }; // touches a
+    SWI2CPollJob jc = { .address = SLAVE_ADDRESS, .reg = 0x11, .size = 4, .data = c, .period = 20000, .deadline = 5000, .done = done }; // overlaps a and b
+    SWI2CPollJob jd = { .address = SLAVE_ADDRESS, .reg = 0x80, .size = 1, .data = d, .period = 10000, .deadline = 1, .done = done };    // can't make it
+    SWI2CPollJob je = { .address = SLAVE_ADDRESS + 1, .reg = 0x10, .size = 1, .data = e, .period = 10000, .deadline = 5000, .done = done }; // nobody home
+
+    SWI2CPollJob* storage[5];
+    SWI2CPoller poller;
+    CHECK(sw_i2c_poller_init(&poller, &master, now_us, storage, 5) != NULL, "poller init");
+    CHECK(sw_i2c_poller_add(&poller, &ja) && sw_i2c_poller_add(&poller, &jb) && sw_i2c_poller_add(&poller, &jc), "adding jobs");
+    CHECK(sw_i2c_poller_add(&poller, &jd) && sw_i2c_poller_add(&poller, &je), "adding jobs");
+    CHECK(!sw_i2c_poller_add(&poller, &ja), "the poller should be full");
+
+    CHECK(sw_i2c_poller_service(&poller) == 3, "three slaves/ranges should take three bursts");
+    CHECK(order[0] == &jd, "the tightest deadline has to go first");
+    CHECK(poller.stats.dispatches == 5 && poller.stats.coalesced == 2, "a, b and c should share one burst");
+    CHECK(poller.stats.misses == 1 && jd.misses == 1, "d should have missed its deadline");
+    CHECK(poller.stats.failures == 1, "e has no slave");
+    CHECK(a[0] == (0x10 ^ 0xa5) && a[1] == (0x11 ^ 0xa5), "wrong data for a");
+    CHECK(b[0] == (0x12 ^ 0xa5) && b[1] == (0x13 ^ 0xa5), "wrong data for b");
+    CHECK(c[0] == (0x11 ^ 0xa5) && c[3] == (0x14 ^ 0xa5), "wrong data for c");
+    CHECK(d[0] == (0x80 ^ 0xa5), "wrong data for d");
+
+    // run for a while, sleeping between services like a firmware main loop would
+    const uint32_t end = now_us() + 100000;
+    while((int32_t)(now_us() - end) < 0) {
+        sw_i2c_poller_service(&poller);
+        const uint32_t idle = sw_i2c_poller_idle_time(&poller);
+        sw_i2c_master_config(&master)->delay(idle > 1000? 1000: (uint16_t)idle);
+    }
+
+    printf("runs a=%u b=%u c=%u, bursts %u for %u dispatches, %u misses, worst %u us late\n", 
+        (unsigned)ja.runs, (unsigned)jb.runs, (unsigned)jc.runs, (unsigned)poller.stats.bursts, 
+        (unsigned)poller.stats.dispatches, (unsigned)poller.stats.misses, (unsigned)poller.stats.worst_lateness);
+
+    CHECK(ja.runs >= 10 && ja.runs <= 12 && jc.runs >= 5 && jc.runs <= 7, "the jobs didn't keep their periods");
+    CHECK(ja.misses == 0 && jb.misses == 0 && jc.misses == 0, "a, b and c have plenty of time");
+    CHECK(poller.stats.coalesced >= jb.runs, "b should always ride along with a");
+
+    // two slaves whose reads take longer than their period, every job is due again before the other is read
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_sim_add_slave(0, SLAVE_ADDRESS + 1);
+    uint8_t x[4], y[4];
+    SWI2CPollJob jx = { .address = SLAVE_ADDRESS, .reg = 0x10, .size = 4, .data = x, .period = 300, .deadline = 300 };
+    SWI2CPollJob jy = { .address = SLAVE_ADDRESS + 1, .reg = 0x10, .size = 4, .data = y, .period = 300, .deadline = 300 };
+    CHECK(sw_i2c_poller_init(&poller, &master, now_us, storage, 5) != NULL, "poller init");
+    CHECK(sw_i2c_poller_add(&poller, &jx) && sw_i2c_poller_add(&poller, &jy), "adding jobs");
+
+    bool returned = true;
+    uint16_t bursts = 0;
+    for(uint8_t i = 0; i < 10; i++) {
+        const uint16_t n = sw_i2c_poller_service(&poller);
+        returned = returned && n >= 1 && n <= 2;
+        bursts += n;
+    }
+    CHECK(returned, "an overloaded poller should read the due jobs once each and return");
+    CHECK(jx.runs + jy.runs == bursts && jx.runs >= 5 && jy.runs >= 5, "neither job should starve the other");
+    CHECK(jx.misses != 0 && jy.misses != 0 && poller.stats.worst_lateness >= 300, "the overrun should show up as misses");
+    printf("overloaded: %u misses, worst %u us late\n", (unsigned)poller.stats.misses, (unsigned)poller.stats.worst_lateness);
+
+    return sw_i2c_test_result();
+
+}
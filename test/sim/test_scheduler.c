@@ -0,0 +1,97 @@
+/**
+ * \file test_scheduler.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Runs several simulated buses through the scheduler and compares them against the blocking master
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <sw_i2c_scheduler.h>
+#include <sw_i2c_timing.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+#define BUSES SW_I2C_SIM_BUSES
+
+int main(void) {
+
+    static SWI2CMaster masters[BUSES];
+    SWI2CScheduler scheduler;
+    SWI2CTimingChecker checker;
+
+    uint8_t out[BUSES][6], in[BUSES][6];
+    for(uint8_t b = 0; b < BUSES; b++) {
+        for(uint8_t i = 0; i < sizeof(out[b]); i++)
+            out[b][i] = (uint8_t)(b * 16 + i + 1);
+    }
+
+    // the reference, one bus after the other with the blocking calls
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    uint32_t start = sw_i2c_sim_time_ns();
+    for(uint8_t b = 0; b < BUSES; b++) {
+        sw_i2c_master_init(&masters[b], sw_i2c_sim_config(b), 10000);
+        sw_i2c_master_write_reg(&masters[b], SLAVE_ADDRESS, 0x20, out[b], sizeof(out[b]));
+        sw_i2c_master_read_reg(&masters[b], SLAVE_ADDRESS, 0x20, in[b], sizeof(in[b]));
+    }
+    const uint32_t sequential = sw_i2c_sim_time_ns() - start;
+
+    // the same work interleaved, with a missing slave on the last bus
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_sim_set_present(BUSES - 1, false);
+    sw_i2c_timing_checker_init(&checker, true, true);
+    sw_i2c_sim_check_timing(0, &checker);
+    memset(in, 0, sizeof(in));
+
+    CHECK(sw_i2c_scheduler_init(&scheduler, sw_i2c_sim_config(0)->delay) != NULL, "scheduler init");
+    for(uint8_t b = 0; b < BUSES; b++)
+        CHECK(sw_i2c_scheduler_add(&scheduler, &masters[b]) == b, "adding a bus");
+    CHECK(sw_i2c_scheduler_add(&scheduler, &masters[0]) == -1, "the scheduler should be full");
+
+    SWI2CJob writes[BUSES], reads[BUSES];
+    start = sw_i2c_sim_time_ns();
+    for(uint8_t b = 0; b < BUSES; b++) {
+        writes[b] = (SWI2CJob){ .kind = SW_I2C_JOB_WRITE_REG, .address = SLAVE_ADDRESS, .reg = 0x20, .data = out[b], .size = sizeof(out[b]) };
+        reads[b] = (SWI2CJob){ .kind = SW_I2C_JOB_READ_REG, .address = SLAVE_ADDRESS, .reg = 0x20, .data = in[b], .size = sizeof(in[b]) };
+        CHECK(sw_i2c_scheduler_submit(&scheduler, b, &writes[b]), "submitting a write");
+    }
+    CHECK(!sw_i2c_scheduler_submit(&scheduler, 0, &reads[0]), "a busy bus should refuse a job");
+    sw_i2c_scheduler_run(&scheduler);
+
+    // a read has to have a byte to NACK, like with sw_i2c_master_try_read
+    SWI2CJob empty = { .kind = SW_I2C_JOB_READ, .address = SLAVE_ADDRESS, .data = in[0], .size = 0 };
+    CHECK(!sw_i2c_scheduler_submit(&scheduler, 0, &empty), "an empty read should be refused");
+    empty.kind = SW_I2C_JOB_READ_REG;
+    CHECK(!sw_i2c_scheduler_submit(&scheduler, 0, &empty), "an empty register read should be refused");
+
+    for(uint8_t b = 0; b < BUSES; b++) {
+        CHECK(sw_i2c_scheduler_submit(&scheduler, b, &reads[b]), "submitting a read");
+    }
+    sw_i2c_scheduler_run(&scheduler);
+    const uint32_t interleaved = sw_i2c_sim_time_ns() - start;
+
+    for(uint8_t b = 0; b < BUSES - 1; b++) {
+        CHECK(!writes[b].busy && writes[b].done == sizeof(out[b]), "write not finished");
+        CHECK(!reads[b].busy && reads[b].done == sizeof(in[b]), "read not finished");
+        CHECK(memcmp(in[b], out[b], sizeof(in[b])) == 0, "read back the wrong data");
+        CHECK(!masters[b].started, "the bus was left started");
+    }
+    CHECK(writes[BUSES - 1].done == 0 && reads[BUSES - 1].done == 0, "the missing slave should transfer nothing");
+    CHECK(!masters[BUSES - 1].started, "a NACK should still release the bus");
+
+    CHECK(sw_i2c_timing_checker_violations(&checker, SW_I2C_MODE_STANDARD) == 0, "interleaving broke the bus timing");
+
+    printf("%u buses: sequential %" PRIu32 " us, interleaved %" PRIu32 " us\n", BUSES, sequential / 1000, interleaved / 1000);
+    CHECK(interleaved * 2 < sequential, "interleaving should be much faster than running the buses one by one");
+
+    return sw_i2c_test_result();
+
+}
@@ -0,0 +1,123 @@
+/**
+ * \file test_status.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Makes transactions on the simulated bus fail in every phase and checks the status, where it failed and that the bus is released
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sw_i2c_master.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+
+static bool released(const SWI2CMaster* const master) {
+
+    const uint32_t lines = SW_I2C_SIM_PORT_SCL(0) | SW_I2C_SIM_PORT_SDA(0);
+    return !master->started && (sw_i2c_sim_port_read() & lines) == lines;
+
+}
+
+#if SW_I2C_ENABLE_TRACE
+static uint32_t now_us(void) { return sw_i2c_sim_time_ns() / 1000; }
+#endif
+
+static bool result_is(const SWI2CResult* const result, const SWI2CStatus status, const SWI2CPhase phase, const uint16_t offset) {
+
+    return result->status == status && result->phase == phase && result->offset == offset;
+
+}
+
+int main(void) {
+
+    SWI2CMaster master;
+    SWI2CResult result;
+    uint8_t data[8] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 };
+    uint8_t in[8];
+
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_master_init(&master, sw_i2c_sim_config(0), 1000);
+
+    CHECK(sw_i2c_master_try_write_reg(&master, SLAVE_ADDRESS, 0x10, data, sizeof(data), &result) == SW_I2C_OK, "write");
+    CHECK(result_is(&result, SW_I2C_OK, SW_I2C_PHASE_DATA, sizeof(data)), "a good write");
+    CHECK(sw_i2c_master_try_read_reg(&master, SLAVE_ADDRESS, 0x10, in, sizeof(in), &result) == SW_I2C_OK, "read");
+    CHECK(result_is(&result, SW_I2C_OK, SW_I2C_PHASE_DATA, sizeof(in)) && memcmp(in, data, sizeof(in)) == 0, "a good read");
+
+    // nobody there, the old calls used to leave the bus started
+    CHECK(sw_i2c_master_try_write_reg(&master, SLAVE_ADDRESS + 1, 0x10, data, sizeof(data), &result) == SW_I2C_NACK, "missing slave");
+    CHECK(result_is(&result, SW_I2C_NACK, SW_I2C_PHASE_ADDRESS, 0), "missing slave result");
+    CHECK(released(&master), "the bus should be released after an address NACK");
+    CHECK(sw_i2c_master_read_reg(&master, SLAVE_ADDRESS + 1, 0x10, in, sizeof(in)) == 0, "missing slave read_reg");
+    CHECK(released(&master), "read_reg should release the bus too");
+    CHECK(sw_i2c_master_try_read(&master, SLAVE_ADDRESS + 1, in, 1, NULL) == SW_I2C_NACK, "the result is optional");
+
+    // the write stops right where the slave refuses it, and the rest can be retried from there
+    sw_i2c_sim_set_read_only(0, 0x34);
+    uint32_t before = sw_i2c_sim_time_ns();
+    CHECK(sw_i2c_master_try_write_reg(&master, SLAVE_ADDRESS, 0x30, data, sizeof(data), &result) == SW_I2C_NACK, "write protected");
+    CHECK(result_is(&result, SW_I2C_NACK, SW_I2C_PHASE_DATA, 4), "the write should fail at the first protected register");
+    CHECK(released(&master), "the bus should be released after a data NACK");
+    const uint32_t failed_ns = sw_i2c_sim_time_ns() - before;
+
+    sw_i2c_sim_set_read_only(0, SW_I2C_SIM_REGS);
+    before = sw_i2c_sim_time_ns();
+    CHECK(sw_i2c_master_try_write_reg(&master, SLAVE_ADDRESS, 0x30 + result.offset, data + result.offset, sizeof(data) - result.offset, &result) == SW_I2C_OK, "retry");
+    CHECK(memcmp(sw_i2c_sim_registers(0) + 0x30, data, sizeof(data)) == 0, "the retry should finish the write");
+    printf("failed write %u us, retry of the rest %u us\n", (unsigned)(failed_ns / 1000), (unsigned)((sw_i2c_sim_time_ns() - before) / 1000));
+
+    // a register NACK and a slave that holds SDA through the final NACK
+    sw_i2c_sim_set_read_only(0, 0);
+    CHECK(sw_i2c_master_write_reg(&master, SLAVE_ADDRESS, 0x10, data, sizeof(data)) == 0, "write_reg into protected registers");
+    CHECK(released(&master), "write_reg should release the bus");
+    sw_i2c_sim_set_read_only(0, SW_I2C_SIM_REGS);
+
+    sw_i2c_start(&master);
+    CHECK(sw_i2c_master_connect_slave(&master, SLAVE_ADDRESS, false), "connect");
+    sw_i2c_sim_set_stuck(0, true);
+    uint8_t byte = 0x5a;
+    CHECK(!sw_i2c_master_try_read_byte(&master, &byte, I2C_NACK), "a held SDA should fail the NACK");
+    CHECK(byte == 0x5a, "a failed read should not touch the data");
+    sw_i2c_sim_set_stuck(0, false);
+    sw_i2c_stop(&master);
+
+#if SW_I2C_ENABLE_TRACE
+    SWI2CTrace trace;
+    SWI2CTraceRecord records[2], record;
+    sw_i2c_trace_init(&trace, records, 2, now_us);
+    sw_i2c_master_trace_attach(&master, &trace);
+#endif
+    sw_i2c_sim_set_stuck(0, true);
+    CHECK(sw_i2c_master_try_read(&master, SLAVE_ADDRESS, in, 4, &result) == SW_I2C_BUS_ERROR, "stuck read");
+    CHECK(result_is(&result, SW_I2C_BUS_ERROR, SW_I2C_PHASE_DATA, 3), "the read should fail at the byte that was NACKed");
+#if SW_I2C_ENABLE_TRACE
+    sw_i2c_master_trace_attach(&master, NULL);
+    CHECK(sw_i2c_trace_pop(&trace, &record), "the failed read should be traced");
+    CHECK(record.acks == 0xf && record.length == 3, "the address and the 3 bytes read were all ACKed");
+    CHECK(record.flags == (SW_I2C_TRACE_READ | SW_I2C_TRACE_NACK), "the failed read flags");
+#endif
+    CHECK(sw_i2c_master_read_bus(&master, in, 1) == 0, "read_bus should count only the bytes that worked");
+    sw_i2c_sim_set_stuck(0, false);
+    sw_i2c_stop(&master);
+
+    // nonsense never reaches the bus
+    SWI2CMaster fast;
+    CHECK(sw_i2c_master_init(&fast, sw_i2c_sim_config(0), 60000) == NULL, "a period below 2us has no clock delays left");
+    CHECK(sw_i2c_master_init(&fast, sw_i2c_sim_config(0), 50000) != NULL && fast.timing.low == 1, "500 kHz is the fastest clock");
+    before = sw_i2c_sim_time_ns();
+    CHECK(sw_i2c_master_try_read(&master, SLAVE_ADDRESS, in, 0, &result) == SW_I2C_INVALID, "empty read");
+    CHECK(sw_i2c_master_try_read_reg(&master, SLAVE_ADDRESS, 0x10, NULL, 4, &result) == SW_I2C_INVALID, "read into nothing");
+    CHECK(sw_i2c_master_try_write(&master, SLAVE_ADDRESS, NULL, 4, &result) == SW_I2C_INVALID, "write from nothing");
+    CHECK(sw_i2c_sim_time_ns() == before, "an invalid call should not touch the bus");
+    CHECK(sw_i2c_master_try_write(&master, SLAVE_ADDRESS, NULL, 0, &result) == SW_I2C_OK, "an empty write probes the address");
+
+    return sw_i2c_test_result();
+
+}
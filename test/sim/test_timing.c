@@ -0,0 +1,103 @@
+/**
+ * \file test_timing.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Runs the master on the simulated bus, checks the edges against the spec and reports the minimum compliant delays
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <sw_i2c_master.h>
+#include <sw_i2c_timing.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+
+static const char* const mode_names[SW_I2C_MODE_COUNT] = { "Standard", "Fast", "Fast-mode Plus" };
+static const char* const param_names[SW_I2C_T_COUNT] = { "tHD;STA", "tSU;STA", "tSU;DAT", "tHD;DAT", "tLOW", "tHIGH", "tSU;STO", "tBUF" };
+
+// puts the master through every kind of phase: starts, restarts, stops, writes, reads and ACKs
+static bool exercise(SWI2CMaster* const master, SWI2CTimingChecker* const checker) {
+
+    sw_i2c_timing_checker_init(checker, true, true);
+    sw_i2c_sim_check_timing(0, checker);
+
+    const uint8_t out[4] = { 0x5a, 0xa5, 0x00, 0xff };
+    uint8_t in[4] = { 0 };
+
+    bool ok = sw_i2c_master_write_reg(master, SLAVE_ADDRESS, 0x10, out, sizeof(out)) == sizeof(out);
+    ok &= sw_i2c_master_read_reg(master, SLAVE_ADDRESS, 0x10, in, sizeof(in)) == sizeof(in);
+    ok &= memcmp(in, out, sizeof(in)) == 0;
+    ok &= sw_i2c_master_read(master, SLAVE_ADDRESS, in, 2) == 2;
+
+    sw_i2c_sim_check_timing(0, NULL);
+    return ok;
+
+}
+
+static void print_timing(const char* const name, const SWI2CTiming* const t) {
+
+    printf("  %-16s hd_sta=%u su_sta=%u su_sto=%u buf=%u low=%u high=%u us\n", name, t->hd_sta, t->su_sta, t->su_sto, t->buf, t->low, t->high);
+
+}
+
+static void check_mode(const uint32_t gpio_ns, const SWI2CMode mode) {
+
+    SWI2CMaster master;
+    SWI2CTimingChecker checker;
+
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_sim_set_gpio_cost(gpio_ns);
+    CHECK(sw_i2c_master_init(&master, sw_i2c_sim_config(0), 10000) != NULL, "master init");
+
+    const SWI2CTiming padded = master.timing;
+    CHECK(exercise(&master, &checker), "transfer with the default delays");
+
+    SWI2CTiming suggested;
+    sw_i2c_timing_checker_suggest(&checker, mode, &padded, &suggested);
+    printf("%s (gpio %" PRIu32 " ns), violations with the default delays: 0x%02x\n", mode_names[mode], gpio_ns, sw_i2c_timing_checker_violations(&checker, mode));
+    print_timing("default", &padded);
+    print_timing("minimum", &suggested);
+
+    sw_i2c_master_set_timing(&master, &suggested);
+    CHECK(exercise(&master, &checker), "transfer with the suggested delays");
+    CHECK(sw_i2c_timing_checker_violations(&checker, mode) == 0, "the suggested delays are not compliant");
+
+    for(uint8_t i = 0; i < SW_I2C_T_COUNT; i++)
+        printf("    %-8s min %6" PRIu32 " ns, spec %5" PRIu32 " ns\n", param_names[i], checker.min_ns[i], sw_i2c_timing_spec_ns(mode, (SWI2CTimingParam)i));
+
+    // shaving another microsecond off any phase has to break compliance, otherwise it wasn't the minimum
+    uint16_t* const phases = (uint16_t*)&suggested;
+    for(uint8_t i = 0; i < sizeof(SWI2CTiming) / sizeof(uint16_t); i++) {
+        if(phases[i] == 0)
+            continue;
+
+        SWI2CTiming shaved = suggested;
+        ((uint16_t*)&shaved)[i]--;
+        sw_i2c_master_set_timing(&master, &shaved);
+        exercise(&master, &checker);
+        CHECK(sw_i2c_timing_checker_violations(&checker, mode) != 0, "a suggested delay is not the minimum");
+    }
+
+    sw_i2c_master_deinit(&master);
+
+}
+
+int main(void) {
+
+    for(uint8_t mode = 0; mode < SW_I2C_MODE_COUNT; mode++) {
+        check_mode(0, (SWI2CMode)mode);
+        check_mode(150, (SWI2CMode)mode);
+    }
+
+    return sw_i2c_test_result();
+
+}
@@ -0,0 +1,112 @@
+/**
+ * \file test_trace.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Traces transactions on the simulated bus and checks the records, the ring and the encoding
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ * Given a path, the encoded records of the first transactions are written there for the sw_i2c_trace_dump tests
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sw_i2c_master.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+#define CAPACITY      4
+
+static uint32_t now_us(void) { return sw_i2c_sim_time_ns() / 1000; }
+
+static bool record_is(const SWI2CTraceRecord* const record, const uint8_t address, const uint8_t flags, const uint32_t acks, const uint16_t length) {
+
+    return record->address == address && record->flags == flags && record->acks == acks && record->length == length;
+
+}
+
+int main(int argc, char** argv) {
+
+    SWI2CMaster master;
+    SWI2CTrace trace;
+    SWI2CTraceRecord storage[CAPACITY];
+    SWI2CTraceRecord records[CAPACITY];
+
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_master_init(&master, sw_i2c_sim_config(0), 1000);
+    CHECK(sw_i2c_trace_init(&trace, storage, 3, now_us) == NULL, "the capacity has to be a power of two");
+    CHECK(sw_i2c_trace_init(&trace, storage, CAPACITY, now_us) == &trace, "init");
+    sw_i2c_master_trace_attach(&master, &trace);
+
+    // one of each kind, the last one fills the ring
+    const uint8_t out[2] = { 0x12, 0x34 };
+    uint8_t in[2];
+    sw_i2c_master_write_reg(&master, SLAVE_ADDRESS, 0x10, out, sizeof(out));
+    sw_i2c_master_read_reg(&master, SLAVE_ADDRESS, 0x10, in, sizeof(in));
+    sw_i2c_master_write(&master, SLAVE_ADDRESS + 1, out, sizeof(out));
+    sw_i2c_master_read(&master, SLAVE_ADDRESS, in, 1);
+    CHECK(sw_i2c_trace_count(&trace) == CAPACITY && trace.dropped == 0, "every transaction should be recorded");
+
+    sw_i2c_master_read(&master, SLAVE_ADDRESS, in, 1);
+    CHECK(sw_i2c_trace_count(&trace) == CAPACITY && trace.dropped == 1, "a full ring should drop and count");
+
+    for(uint8_t i = 0; i < CAPACITY; i++)
+        CHECK(sw_i2c_trace_pop(&trace, &records[i]), "pop");
+    CHECK(sw_i2c_trace_count(&trace) == 0, "the ring should be empty");
+
+    CHECK(record_is(&records[0], SLAVE_ADDRESS, SW_I2C_TRACE_REG, 0xf, 2), "register write");
+    CHECK(record_is(&records[1], SLAVE_ADDRESS, SW_I2C_TRACE_READ | SW_I2C_TRACE_REG, 0xf, 2), "register read");
+    CHECK(record_is(&records[2], SLAVE_ADDRESS + 1, SW_I2C_TRACE_NACK, 0, 0), "write to nobody");
+    CHECK(record_is(&records[3], SLAVE_ADDRESS, SW_I2C_TRACE_READ, 0x1, 1), "plain read");
+
+    // the records are stamped with the bus clock, one after the other
+    CHECK(records[0].timestamp == 0 && records[0].duration != 0, "first stamp");
+    for(uint8_t i = 1; i < CAPACITY; i++)
+        CHECK(records[i].timestamp >= records[i - 1].timestamp + records[i - 1].duration, "records should not overlap");
+
+    // the encoding is fixed little endian, whatever the host is
+    uint8_t encoded[CAPACITY][SW_I2C_TRACE_RECORD_SIZE];
+    const SWI2CTraceRecord sample = { .timestamp = 0x04030201, .duration = 0x08070605, .acks = 0x0c0b0a09, .length = 0x0e0d, .address = 0x0f, .flags = 0x10 };
+    sw_i2c_trace_encode(&sample, encoded[0]);
+    for(uint8_t i = 0; i < SW_I2C_TRACE_RECORD_SIZE; i++)
+        CHECK(encoded[0][i] == i + 1, "encoded layout");
+
+    for(uint8_t i = 0; i < CAPACITY; i++) {
+        SWI2CTraceRecord decoded;
+        sw_i2c_trace_encode(&records[i], encoded[i]);
+        sw_i2c_trace_decode(&decoded, encoded[i]);
+        CHECK(decoded.timestamp == records[i].timestamp && decoded.duration == records[i].duration, "decoded times");
+        CHECK(record_is(&decoded, records[i].address, records[i].flags, records[i].acks, records[i].length), "decoded record");
+    }
+
+    // run the indices around the ring and past the wrap of their 16 bits, in order and without drops
+    SWI2CTraceRecord record = { 0 };
+    sw_i2c_trace_init(&trace, storage, CAPACITY, now_us);
+    uint32_t next = 0;
+    for(uint32_t i = 0; i < 70000; i++) {
+        record.timestamp = i;
+        sw_i2c_trace_push(&trace, &record);
+        if(i % 3 == 2) { // the reader runs behind and catches up now and then
+            while(sw_i2c_trace_pop(&trace, &record)) {
+                if(record.timestamp != next++)
+                    failures++;
+            }
+        }
+    }
+    CHECK(next == 70000 - (70000 % 3) && trace.dropped == 0, "records should come out in order across the wrap");
+
+    if(argc > 1) {
+        FILE* const file = fopen(argv[1], "wb");
+        CHECK(file != NULL && fwrite(encoded, sizeof(encoded), 1, file) == 1, "writing the trace file");
+        if(file)
+            fclose(file);
+    }
+
+    return sw_i2c_test_result();
+
+}
@@ -0,0 +1,97 @@
+/**
+ * \file test_wait.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Waits for a status bit on the simulated bus, continuously and with repeated starts, against a read_reg loop
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <stdio.h>
+
+#include <sw_i2c_master.h>
+#include <sw_i2c_timing.h>
+
+#include "sw_i2c_sim.h"
+#include "sw_i2c_test.h"
+
+#define SLAVE_ADDRESS 0x42
+#define STATUS        0x10
+#define BUSY          0x01
+#define READY         0x80
+#define READY_NS      20000000u     // the conversion finishes after 20ms
+
+// a slave that turns ready at READY_NS, the register after the status looks ready to catch a wrong pointer
+static void setup(SWI2CMaster* const master, const bool increment) {
+
+    sw_i2c_sim_reset(SLAVE_ADDRESS);
+    sw_i2c_sim_set_increment(0, increment);
+    sw_i2c_sim_registers(0)[STATUS] = BUSY;
+    sw_i2c_sim_registers(0)[STATUS + 1] = READY;
+    sw_i2c_sim_write_at(0, STATUS, READY, READY_NS);
+    sw_i2c_master_init(master, sw_i2c_sim_config(0), 1000);
+
+}
+
+int main(void) {
+
+    SWI2CMaster master;
+    SWI2CTimingChecker checker;
+    uint8_t status = 0;
+
+    // the old way, a whole transaction per poll
+    setup(&master, false);
+    do {
+        sw_i2c_master_read_reg(&master, SLAVE_ADDRESS, STATUS, &status, 1);
+    } while(!(status & READY));
+    const uint32_t loop_starts = sw_i2c_sim_starts(0);
+    const uint32_t loop_late = sw_i2c_sim_time_ns() - READY_NS;
+
+    // a continuous device is addressed once and then just clocked
+    setup(&master, false);
+    sw_i2c_timing_checker_init(&checker, true, true);
+    sw_i2c_sim_check_timing(0, &checker);
+    CHECK(sw_i2c_master_wait_reg(&master, SLAVE_ADDRESS, STATUS, READY, READY, 1000, 100, true, &status) == SW_I2C_OK, "continuous wait");
+    CHECK(status == READY, "continuous status");
+    CHECK(sw_i2c_sim_starts(0) == 2, "a continuous wait should only start and restart once");
+    CHECK(!master.started, "the bus should be stopped");
+    CHECK(sw_i2c_timing_checker_violations(&checker, SW_I2C_MODE_STANDARD) == 0, "waiting broke the bus timing");
+    const uint32_t continuous_late = sw_i2c_sim_time_ns() - READY_NS;
+    sw_i2c_sim_check_timing(0, NULL);
+
+    printf("read_reg loop: %u starts, done %u us after ready\n", (unsigned)loop_starts, (unsigned)(loop_late / 1000));
+    printf("continuous:    %u starts, done %u us after ready\n", (unsigned)sw_i2c_sim_starts(0), (unsigned)(continuous_late / 1000));
+    CHECK(continuous_late < loop_late, "the continuous wait should notice sooner");
+
+    // an auto incrementing device gets its pointer set again on every poll, still without a STOP
+    setup(&master, true);
+    CHECK(sw_i2c_master_wait_reg(&master, SLAVE_ADDRESS, STATUS, READY, READY, 1000, 0, false, &status) == SW_I2C_OK, "repeated start wait");
+    CHECK(status == READY && sw_i2c_sim_time_ns() >= READY_NS, "the wait read the wrong register");
+    CHECK(sw_i2c_sim_starts(0) > 2 && sw_i2c_sim_starts(0) % 2 == 0, "every poll should restart twice");
+    printf("repeated start: %u starts, done %u us after ready\n", (unsigned)sw_i2c_sim_starts(0), (unsigned)((sw_i2c_sim_time_ns() - READY_NS) / 1000));
+
+    // running out of polls releases the bus with the last status
+    setup(&master, false);
+    CHECK(sw_i2c_master_wait_reg(&master, SLAVE_ADDRESS, STATUS, READY, READY, 5, 0, true, &status) == SW_I2C_TIMEOUT, "timeout");
+    CHECK(status == BUSY && !master.started, "timeout status");
+    CHECK(sw_i2c_master_read_reg(&master, SLAVE_ADDRESS, STATUS + 1, &status, 1) == 1 && status == READY, "bus after a timeout");
+
+    // and so does a missing slave
+    setup(&master, false);
+    sw_i2c_sim_set_present(0, false);
+    status = BUSY;
+    CHECK(sw_i2c_master_wait_reg(&master, SLAVE_ADDRESS, STATUS, READY, READY, 5, 0, true, &status) == SW_I2C_NACK, "missing slave");
+    CHECK(status == 0, "a NACK should clear the status");
+    CHECK(!master.started, "the bus should be stopped after a NACK");
+
+    // no polls at all is refused without touching the bus, but the status is still written
+    setup(&master, false);
+    status = BUSY;
+    CHECK(sw_i2c_master_wait_reg(&master, SLAVE_ADDRESS, STATUS, READY, READY, 0, 0, true, &status) == SW_I2C_INVALID, "no polls");
+    CHECK(status == 0 && sw_i2c_sim_starts(0) == 0, "no polls status");
+
+    return sw_i2c_test_result();
+
+}
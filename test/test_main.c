@@ -25,22 +25,22 @@ TEST_CASE("GPIO Works Properly", "[sw_i2c]")
     SWI2CMaster master;
     i2c_init(&master);
 
-    master.config.scl_write(1);
-    master.config.delay(5);
-    TEST_ASSERT_EQUAL_MESSAGE(1, master.config.scl_read(), "Clock Isn't High");
-    master.config.delay(5);
-    master.config.scl_write(0);
-    master.config.delay(5);
-    TEST_ASSERT_EQUAL_MESSAGE(0, master.config.scl_read(), "Clock Isn't Low");
-    master.config.delay(5);
-
-    master.config.sda_write(1);
-    master.config.delay(5);
-    TEST_ASSERT_EQUAL_MESSAGE(1, master.config.sda_read(), "Data Isn't High");
-    master.config.delay(5);
-    master.config.sda_write(0);
-    master.config.delay(5);
-    TEST_ASSERT_EQUAL_MESSAGE(0, master.config.sda_read(), "Data Line Isnt Low");
+    sw_i2c_master_config(&master)->scl_write(1);
+    sw_i2c_master_config(&master)->delay(5);
+    TEST_ASSERT_EQUAL_MESSAGE(1, sw_i2c_master_config(&master)->scl_read(), "Clock Isn't High");
+    sw_i2c_master_config(&master)->delay(5);
+    sw_i2c_master_config(&master)->scl_write(0);
+    sw_i2c_master_config(&master)->delay(5);
+    TEST_ASSERT_EQUAL_MESSAGE(0, sw_i2c_master_config(&master)->scl_read(), "Clock Isn't Low");
+    sw_i2c_master_config(&master)->delay(5);
+
+    sw_i2c_master_config(&master)->sda_write(1);
+    sw_i2c_master_config(&master)->delay(5);
+    TEST_ASSERT_EQUAL_MESSAGE(1, sw_i2c_master_config(&master)->sda_read(), "Data Isn't High");
+    sw_i2c_master_config(&master)->delay(5);
+    sw_i2c_master_config(&master)->sda_write(0);
+    sw_i2c_master_config(&master)->delay(5);
+    TEST_ASSERT_EQUAL_MESSAGE(0, sw_i2c_master_config(&master)->sda_read(), "Data Line Isnt Low");
 
     sw_i2c_master_deinit(&master);
     gpio_deinit();
@@ -55,10 +55,10 @@ TEST_CASE("I2C Can Start and Stop", "[sw_i2c]")
     i2c_init(&master);
 
     sw_i2c_start(&master);
-    TEST_ASSERT_EQUAL_MESSAGE(0, master.config.sda_read(), "Start Didn't Pull the Data Line High");
+    TEST_ASSERT_EQUAL_MESSAGE(0, sw_i2c_master_config(&master)->sda_read(), "Start Didn't Pull the Data Line High");
 
     sw_i2c_stop(&master);
-    TEST_ASSERT_EQUAL_MESSAGE(1, master.config.sda_read(), "Stop Didn't Pull the Data Line Low");
+    TEST_ASSERT_EQUAL_MESSAGE(1, sw_i2c_master_config(&master)->sda_read(), "Stop Didn't Pull the Data Line Low");
 
     sw_i2c_master_deinit(&master);
     gpio_deinit();
@@ -72,13 +72,13 @@ TEST_CASE("I2C Can Write And Read a Bit", "[sw_i2c]")
     SWI2CMaster master;
     i2c_init(&master);
 
-    master.config.scl_write(0);
+    sw_i2c_master_config(&master)->scl_write(0);
     
     sw_i2c_master_write_bit(&master, 0);
-    TEST_ASSERT_EQUAL_MESSAGE(0, master.config.sda_read(), "Master Didn't Drive the Channel to 0");
+    TEST_ASSERT_EQUAL_MESSAGE(0, sw_i2c_master_config(&master)->sda_read(), "Master Didn't Drive the Channel to 0");
 
     sw_i2c_master_write_bit(&master, 1);
-    TEST_ASSERT_EQUAL_MESSAGE(1, master.config.sda_read(), "Master Didn't Write the Bit Appropriately");
+    TEST_ASSERT_EQUAL_MESSAGE(1, sw_i2c_master_config(&master)->sda_read(), "Master Didn't Write the Bit Appropriately");
 
     TEST_ASSERT_EQUAL_MESSAGE(1, sw_i2c_master_read_bit(&master), "Master Couldn't Read The 1 Bit Correctly");
     
@@ -100,11 +100,11 @@ TEST_CASE("I2C Can Write a Byte Correctly", "[sw_i2c]") {
     SWI2CMaster master;
     i2c_init(&master);
 
-    master.config.delay(1000);
+    sw_i2c_master_config(&master)->delay(1000);
 
     for(uint8_t i = 0x80; i != 0; i >>= 1) {
         sw_i2c_master_write_bit(&master, (data & i) != 0);
-        TEST_ASSERT_EQUAL_MESSAGE(((data & i) != 0), master.config.sda_read(), "Master Didn't Drive the Channel to The Correct level");
+        TEST_ASSERT_EQUAL_MESSAGE(((data & i) != 0), sw_i2c_master_config(&master)->sda_read(), "Master Didn't Drive the Channel to The Correct level");
     }
     
     sw_i2c_master_deinit(&master);
@@ -239,4 +239,47 @@ TEST_CASE("I2C Can Read And Write To a Register", "[sw_i2c]")
     sw_i2c_master_deinit(&master);
     gpio_deinit();
 
-}
\ No newline at end of file
+}
+
+#if SW_I2C_ENABLE_TRACE
+
+static uint32_t trace_clock(void) { 
+    
+    static uint32_t ticks = 0; 
+    return ticks++; 
+
+}
+
+TEST_CASE("I2C Traces Transactions", "[sw_i2c]") 
+{
+
+    gpio_init();
+    SWI2CMaster master;
+    i2c_init(&master);
+
+    static SWI2CTraceRecord records[4];
+    SWI2CTrace trace;
+    TEST_ASSERT_MESSAGE(sw_i2c_trace_init(&trace, records, 4, trace_clock) != NULL, "Couldn't Initialize the Trace");
+    sw_i2c_master_trace_attach(&master, &trace);
+
+    const uint8_t s_addr = slave_address_get();
+    const uint8_t r_addr = slave_reg_address_get();
+    uint16_t data = 0;
+    TEST_ASSERT_EQUAL_MESSAGE(2, sw_i2c_master_read_reg(&master, s_addr, r_addr, &data, 2), "Couldn't Read 2 Bytes from the device register");
+
+    SWI2CTraceRecord record;
+    TEST_ASSERT_EQUAL_MESSAGE(1, sw_i2c_trace_count(&trace), "The Transaction Wasn't Recorded");
+    TEST_ASSERT_MESSAGE(sw_i2c_trace_pop(&trace, &record), "Couldn't Read the Record Back");
+    TEST_ASSERT_EQUAL_MESSAGE(s_addr, record.address, "The Record Has the Wrong Address");
+    TEST_ASSERT_EQUAL_MESSAGE(2, record.length, "The Record Has the Wrong Length");
+    TEST_ASSERT_EQUAL_MESSAGE(SW_I2C_TRACE_READ | SW_I2C_TRACE_REG, record.flags, "The Record Has the Wrong Flags");
+    TEST_ASSERT_EQUAL_MESSAGE(0xf, record.acks, "The Record Has the Wrong ACK Pattern");
+    TEST_ASSERT_EQUAL_MESSAGE(1, record.duration, "The Record Has the Wrong Duration");
+    TEST_ASSERT_FALSE_MESSAGE(sw_i2c_trace_pop(&trace, &record), "The Ring Should Be Empty");
+
+    sw_i2c_master_deinit(&master);
+    gpio_deinit();
+
+}
+
+#endif
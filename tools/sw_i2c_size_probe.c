@@ -0,0 +1,28 @@
+/**
+ * \file sw_i2c_size_probe.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief One master and one config, linked into the size_report builds so the per bus cost shows up in the sections
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ */
+
+#include <sw_i2c_master.h>
+
+static void probe_write(const bool state) { (void)state; }
+static bool probe_read(void) { return true; }
+static void probe_delay(const uint16_t useconds) { (void)useconds; }
+
+const SWI2CConfig sw_i2c_size_probe_config = {
+
+    .sda_write = probe_write,
+    .scl_write = probe_write,
+    .sda_read = probe_read,
+    .scl_read = probe_read,
+    .delay = probe_delay
+
+};
+
+SWI2CMaster sw_i2c_size_probe_master;
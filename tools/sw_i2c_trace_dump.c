@@ -0,0 +1,136 @@
+/**
+ * \file sw_i2c_trace_dump.c
+ * \author Orion Serup (orionserup@gmail.com)
+ * \brief Host tool that decodes a dumped sw_i2c trace into a text log or a VCD file
+ * \version 0.1
+ * \date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2022
+ * 
+ * The input is a plain sequence of records encoded with sw_i2c_trace_encode
+ * 
+ * Usage: sw_i2c_trace_dump [--vcd] [--timescale <vcd timescale>] <trace file>
+ * 
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <sw_i2c_trace.h>
+
+static void print_bits(FILE* const out, const uint32_t value, const uint8_t width) {
+
+    for(uint8_t i = width; i != 0; i--)
+        fputc((value >> (i - 1)) & 1? '1': '0', out);
+
+}
+
+// VCD wants strictly increasing time stamps, so only emit one when time moved on
+static void vcd_time(FILE* const out, uint64_t* const printed, const uint64_t time) {
+
+    if(*printed != time)
+        fprintf(out, "#%" PRIu64 "\n", time);
+    *printed = time;
+
+}
+
+static void dump_text(FILE* const in, FILE* const out) {
+
+    uint8_t buffer[SW_I2C_TRACE_RECORD_SIZE];
+    SWI2CTraceRecord record;
+    uint32_t n = 0;
+
+    while(fread(buffer, sizeof(buffer), 1, in) == 1) {
+
+        sw_i2c_trace_decode(&record, buffer);
+        fprintf(out, "%6" PRIu32 " t=%10" PRIu32 " dur=%8" PRIu32 " %c%s addr=0x%02x len=%5u acks=0x%08" PRIx32 "%s\n", 
+            n++, record.timestamp, record.duration, 
+            (record.flags & SW_I2C_TRACE_READ)? 'R': 'W', (record.flags & SW_I2C_TRACE_REG)? " reg": "    ",
+            record.address, record.length, record.acks, (record.flags & SW_I2C_TRACE_NACK)? " NACK": "");
+
+    }
+
+}
+
+static void dump_vcd(FILE* const in, FILE* const out, const char* const timescale) {
+
+    fprintf(out, "$timescale %s $end\n", timescale);
+    fprintf(out, "$scope module sw_i2c $end\n");
+    fprintf(out, "$var wire 1 b busy $end\n");
+    fprintf(out, "$var wire 1 r read $end\n");
+    fprintf(out, "$var wire 1 n nack $end\n");
+    fprintf(out, "$var wire 7 a address [6:0] $end\n");
+    fprintf(out, "$var wire 16 l length [15:0] $end\n");
+    fprintf(out, "$var wire 32 k acks [31:0] $end\n");
+    fprintf(out, "$upscope $end\n$enddefinitions $end\n");
+    fprintf(out, "#0\n$dumpvars\n0b\n0r\n0n\nb0 a\nb0 l\nb0 k\n$end\n");
+
+    uint8_t buffer[SW_I2C_TRACE_RECORD_SIZE];
+    SWI2CTraceRecord record;
+    uint64_t now = 0, end = 0, printed = 0;
+    uint32_t last = 0;
+    bool first = true;
+
+    while(fread(buffer, sizeof(buffer), 1, in) == 1) {
+
+        sw_i2c_trace_decode(&record, buffer);
+
+        // the trace clock is 32 bits wide, so unwrap it into a monotonic 64 bit time
+        now += first? record.timestamp: (uint32_t)(record.timestamp - last);
+        last = record.timestamp;
+        first = false;
+
+        if(now < end) // records overlapping because of clock jitter, keep the VCD ordered
+            now = end;
+
+        vcd_time(out, &printed, now);
+        fprintf(out, "1b\n%cr\n%cn\n", 
+            (record.flags & SW_I2C_TRACE_READ)? '1': '0', (record.flags & SW_I2C_TRACE_NACK)? '1': '0');
+        fputc('b', out); print_bits(out, record.address, 7); fputs(" a\n", out);
+        fputc('b', out); print_bits(out, record.length, 16); fputs(" l\n", out);
+        fputc('b', out); print_bits(out, record.acks, 32); fputs(" k\n", out);
+
+        end = now + (record.duration? record.duration: 1);
+        vcd_time(out, &printed, end);
+        fputs("0b\n", out);
+
+    }
+
+}
+
+int main(int argc, char** argv) {
+
+    bool vcd = false;
+    const char* timescale = "1us";
+    const char* path = NULL;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--vcd") == 0)
+            vcd = true;
+        else if(strcmp(argv[i], "--timescale") == 0 && i + 1 < argc)
+            timescale = argv[++i];
+        else
+            path = argv[i];
+    }
+
+    if(path == NULL) {
+        fprintf(stderr, "Usage: %s [--vcd] [--timescale <vcd timescale>] <trace file>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = fopen(path, "rb");
+    if(in == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    if(vcd)
+        dump_vcd(in, stdout, timescale);
+    else
+        dump_text(in, stdout);
+
+    fclose(in);
+    return 0;
+
+}